@@ -0,0 +1,438 @@
+/**
+ * @file   bench.cpp
+ * @author Pratchaya Khansomboon (me@mononerv.dev)
+ * @brief  Render benchmarks over fixed fractal scenes, results as JSON.
+ * @date   2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ */
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "spdlog/spdlog.h"
+#include "spdlog/sinks/stdout_color_sinks.h"
+#include "mono/mono.hpp"
+#include "glad/glad.h"
+
+#include "frame_params.hpp"
+#include "hashlife.hpp"
+#include "life.hpp"
+#include "mandelbrot.hpp"
+#include "perturbation.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+namespace nrv {
+// Command line:
+//   fractals_bench --size 1280x720 --frames 10 --warmup 2 --filter life --cpu-only --output bench.json
+// Without --output the JSON goes to stdout, progress is logged to stderr.
+struct bench_options {
+    std::int32_t width    = 1280;
+    std::int32_t height   = 720;
+    std::int32_t frames   = 10;
+    std::int32_t warmup   = 2;
+    bool         gpu      = true;
+    std::string  filter   = "";
+    std::string  output   = "";
+};
+
+// Work a scene does per frame, pixels and iterations are 0 when they don't apply.
+struct frame_work {
+    mno::f64 pixels     = 0.0;
+    mno::f64 iterations = 0.0;
+};
+
+struct scene_result {
+    std::string           name;
+    std::string           backend;
+    std::vector<mno::f64> frame_ms;
+    frame_work            work;
+    std::size_t           working_set;  // bytes of the scene's own buffers
+    std::size_t           resident;     // process resident set after the scene
+};
+
+static auto parse_options(std::int32_t argc, char const* argv[]) -> bench_options {
+    bench_options opts{};
+    for (std::int32_t i = 1; i < argc; i++) {
+        std::string const arg{argv[i]};
+        auto const has_value = i + 1 < argc;
+        if (arg == "--size" && has_value) {
+            std::string const size{argv[++i]};
+            auto const x = size.find('x');
+            if (x == std::string::npos) throw std::runtime_error("ERROR: --size expects WIDTHxHEIGHT");
+            opts.width  = std::stoi(size.substr(0, x));
+            opts.height = std::stoi(size.substr(x + 1));
+        } else if (arg == "--frames" && has_value) {
+            opts.frames = std::max(std::stoi(argv[++i]), 1);
+        } else if (arg == "--warmup" && has_value) {
+            opts.warmup = std::max(std::stoi(argv[++i]), 0);
+        } else if (arg == "--filter" && has_value) {
+            opts.filter = argv[++i];
+        } else if (arg == "--output" && has_value) {
+            opts.output = argv[++i];
+        } else if (arg == "--cpu-only") {
+            opts.gpu = false;
+        } else {
+            throw std::runtime_error("ERROR: Unknown argument " + arg);
+        }
+    }
+    return opts;
+}
+
+static auto resident_bytes() -> std::size_t {
+#if defined(__linux__)
+    std::ifstream statm{"/proc/self/statm"};
+    std::size_t pages = 0, resident = 0;
+    if (statm >> pages >> resident) return resident * std::size_t(sysconf(_SC_PAGESIZE));
+#endif
+    return 0;
+}
+
+static auto peak_resident_bytes() -> std::size_t {
+#if defined(__unix__) || defined(__APPLE__)
+    rusage usage{};
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#if defined(__APPLE__)
+    return std::size_t(usage.ru_maxrss);
+#else
+    return std::size_t(usage.ru_maxrss) * 1024;  // KiB on Linux and the BSDs
+#endif
+#else
+    return 0;
+#endif
+}
+
+// Nearest rank percentile of sorted samples.
+static auto percentile(std::vector<mno::f64> const& sorted, mno::f64 const& p) -> mno::f64 {
+    if (sorted.empty()) return 0.0;
+    auto const rank = std::size_t(std::ceil(p / 100.0 * mno::f64(sorted.size())));
+    return sorted[std::clamp(rank, std::size_t(1), sorted.size()) - 1];
+}
+
+static auto json_number(mno::f64 const& value) -> std::string {
+    if (!std::isfinite(value)) return "null";
+    std::ostringstream str;
+    str.precision(6);
+    str << value;
+    return str.str();
+}
+
+class bench {
+  public:
+    explicit bench(bench_options const& options) : m_options(options) {}
+
+    // Runs warmup + frames frames of fn and records the timings when name passes the filter.
+    auto run(std::string const& name, std::string const& backend, std::size_t const& working_set,
+             std::function<frame_work()> const& fn) -> void {
+        if (!m_options.filter.empty() && name.find(m_options.filter) == std::string::npos) return;
+        scene_result result{name, backend, {}, {}, working_set, 0};
+        for (std::int32_t i = 0; i < m_options.warmup; i++) fn();
+        for (std::int32_t i = 0; i < m_options.frames; i++) {
+            auto const start = std::chrono::steady_clock::now();
+            result.work = fn();
+            auto const end = std::chrono::steady_clock::now();
+            result.frame_ms.push_back(std::chrono::duration<mno::f64, std::milli>(end - start).count());
+        }
+        result.resident = resident_bytes();
+        auto sorted = result.frame_ms;
+        std::sort(std::begin(sorted), std::end(sorted));
+        spdlog::info("{:<32} {:>6} p50 {:>10.3f} ms", name, backend, percentile(sorted, 50.0));
+        m_results.push_back(std::move(result));
+    }
+
+    auto set_machine(std::string const& key, std::string const& value) -> void {
+        m_machine.emplace_back(key, value);
+    }
+
+    [[nodiscard]] auto json() const -> std::string {
+        std::string str{"{\n"};
+        str += "  \"machine\": {";
+        for (std::size_t i = 0; i < m_machine.size(); i++) {
+            str += (i == 0 ? "\"" : ", \"") + mno::json_escape(m_machine[i].first) + "\": \"" +
+                   mno::json_escape(m_machine[i].second) + "\"";
+        }
+        str += "},\n";
+        str += "  \"settings\": {\"width\": " + std::to_string(m_options.width) +
+               ", \"height\": " + std::to_string(m_options.height) +
+               ", \"frames\": " + std::to_string(m_options.frames) +
+               ", \"warmup\": " + std::to_string(m_options.warmup) + "},\n";
+        str += "  \"peak_resident_bytes\": " + std::to_string(peak_resident_bytes()) + ",\n";
+        str += "  \"scenes\": [\n";
+        for (std::size_t i = 0; i < m_results.size(); i++) {
+            str += "    " + scene_json(m_results[i]) + (i + 1 < m_results.size() ? ",\n" : "\n");
+        }
+        str += "  ]\n}\n";
+        return str;
+    }
+
+  private:
+    static auto scene_json(scene_result const& result) -> std::string {
+        auto sorted = result.frame_ms;
+        std::sort(std::begin(sorted), std::end(sorted));
+        auto const total = std::accumulate(std::begin(sorted), std::end(sorted), 0.0);
+        auto const mean  = total / mno::f64(sorted.size());
+        auto const p50   = percentile(sorted, 50.0);
+        // Rates use the median frame so a stray slow frame doesn't skew them
+        auto const mpixels = result.work.pixels > 0.0 ? result.work.pixels / (p50 * 1e3) : NAN;
+        auto const ns_iter = result.work.iterations > 0.0 ? p50 * 1e6 / result.work.iterations : NAN;
+
+        std::string str{"{"};
+        str += "\"name\": \"" + mno::json_escape(result.name) + "\", ";
+        str += "\"backend\": \"" + mno::json_escape(result.backend) + "\", ";
+        str += "\"frames\": " + std::to_string(sorted.size()) + ", ";
+        str += "\"frame_ms\": {\"min\": " + json_number(sorted.front()) +
+               ", \"mean\": " + json_number(mean) +
+               ", \"p50\": " + json_number(p50) +
+               ", \"p90\": " + json_number(percentile(sorted, 90.0)) +
+               ", \"p99\": " + json_number(percentile(sorted, 99.0)) +
+               ", \"max\": " + json_number(sorted.back()) + "}, ";
+        str += "\"mpixels_per_s\": " + json_number(mpixels) + ", ";
+        str += "\"ns_per_iteration\": " + json_number(ns_iter) + ", ";
+        str += "\"iterations_per_frame\": " + json_number(result.work.iterations) + ", ";
+        str += "\"working_set_bytes\": " + std::to_string(result.working_set) + ", ";
+        str += "\"resident_bytes\": " + std::to_string(result.resident) + "}";
+        return str;
+    }
+
+  private:
+    bench_options                                    m_options;
+    std::vector<std::pair<std::string, std::string>> m_machine{};
+    std::vector<scene_result>                        m_results{};
+};
+
+static auto sum_iterations(std::vector<std::uint32_t> const& iterations) -> mno::f64 {
+    return mno::f64(std::accumulate(std::begin(iterations), std::end(iterations), std::uint64_t(0)));
+}
+
+// Escape-time Mandelbrot at increasing depth, the deepest views switch to
+// f64 kernels and then to perturbation.
+static auto run_mandelbrot(bench& b, bench_options const& opts, mno::tile_scheduler& scheduler) -> void {
+    struct scene {
+        char const*   name;
+        mno::f64      center_x;
+        mno::f64      center_y;
+        mno::f64      scale;
+        std::uint32_t max_iterations;
+    };
+    scene const scenes[]{
+        {"mandelbrot/overview",      -0.5,               0.0,               3.0,  256},
+        {"mandelbrot/seahorse_1e-4", -0.743643887037151, 0.131825904205330, 1e-4, 1024},
+        {"mandelbrot/seahorse_1e-9", -0.743643887037151, 0.131825904205330, 1e-9, 4096},
+    };
+    mno::image image{opts.width, opts.height};
+    auto const pixels = mno::f64(opts.width) * mno::f64(opts.height);
+    for (auto const& s : scenes) {
+        mandelbrot fractal{{s.center_x, s.center_y, s.scale, s.max_iterations}};
+        b.run(s.name, "cpu/" + mno::to_string(fractal.simd_level()), image.size() + std::size_t(pixels) * 4, [&] {
+            fractal.render(image, scheduler);
+            return frame_work{pixels, sum_iterations(fractal.iterations())};
+        });
+    }
+
+    perturbation deep{{"-0.743643887037158704752191506114774", "0.131825904205311970493132056385139", 1e-14, 4096}};
+    b.run("mandelbrot/perturbation_1e-14", "cpu", image.size() + std::size_t(pixels) * 4, [&] {
+        deep.render(image, scheduler);
+        return frame_work{pixels, sum_iterations(deep.iterations())};
+    });
+}
+
+// A frame is 16 generations of a fixed random soup, iterations are cell updates.
+static auto run_life(bench& b, mno::tile_scheduler& scheduler) -> void {
+    constexpr std::int32_t generations = 16;
+    constexpr std::int32_t size        = 4096;
+    struct scene {
+        char const* name;
+        mno::f32    density;
+    };
+    scene const scenes[]{
+        {"life/dense_4096",  0.5f},
+        {"life/sparse_4096", 0.02f},
+    };
+    auto const cells = mno::f64(size) * mno::f64(size) * generations;
+    for (auto const& s : scenes) {
+        life board{size, size};
+        board.randomize(1, s.density);
+        auto const bytes = std::size_t(size / 8) * std::size_t(size) * 2;
+        b.run(s.name, "cpu/" + mno::to_string(board.simd_level()), bytes, [&] {
+            for (std::int32_t i = 0; i < generations; i++) board.step(scheduler);
+            return frame_work{cells, cells};
+        });
+    }
+
+    // Cold HashLife, every frame starts with an empty node store
+    b.run("hashlife/acorn_2^13", "cpu", 0, [] {
+        hashlife universe{};
+        std::int32_t const acorn[][2]{{1, 0}, {3, 1}, {0, 2}, {1, 2}, {4, 2}, {5, 2}, {6, 2}};
+        for (auto const& cell : acorn) universe.set(cell[0], cell[1], true);
+        universe.step(13);
+        return frame_work{0.0, mno::f64(universe.generation())};
+    });
+}
+
+// Shader scenes render offscreen, a frame ends with glFinish so its time
+// covers the GPU work.
+static auto run_gpu(bench& b, bench_options const& opts) -> void {
+    mno::window window{{.title = "fractals_bench", .headless = true}};
+    auto graphics = window.graphics_context();
+    mno::shader::set_cache_directory(".cache/shaders");
+    b.set_machine("gl_vendor", reinterpret_cast<char const*>(glGetString(GL_VENDOR)));
+    b.set_machine("gl_renderer", reinterpret_cast<char const*>(glGetString(GL_RENDERER)));
+    b.set_machine("gl_version", reinterpret_cast<char const*>(glGetString(GL_VERSION)));
+
+    struct vertex {
+        glm::vec3 position;
+        glm::vec4 color;
+        glm::vec2 uv;
+    };
+    vertex vertices[]{
+        {{-1.0f,  1.0f, 0.0f}, {1.0f, 0.0f, 0.0f, 1.0f}, {0.0f, 1.0f}},
+        {{ 1.0f,  1.0f, 0.0f}, {0.0f, 1.0f, 0.0f, 1.0f}, {1.0f, 1.0f}},
+        {{ 1.0f, -1.0f, 0.0f}, {0.0f, 0.0f, 1.0f, 1.0f}, {1.0f, 0.0f}},
+        {{-1.0f, -1.0f, 0.0f}, {1.0f, 0.0f, 1.0f, 1.0f}, {0.0f, 0.0f}},
+    };
+    std::uint32_t indices[]{0, 1, 2, 0, 2, 3};
+    mno::array_buffer quad{};
+    quad.add_vertex_buffer(mno::vertex_buffer::make(vertices, sizeof(vertices), {
+        {mno::shader::type::vec3, "a_position"},
+        {mno::shader::type::vec4, "a_color"},
+        {mno::shader::type::vec2, "a_uv"},
+    }));
+    quad.set_index_buffer(mno::index_buffer::make(indices, sizeof(indices), std::int32_t(std::size(indices))));
+
+    auto load = [](char const* fragment) {
+        auto program = mno::shader::load("./shaders/410.shader.gl.vert", fragment);
+        program->bind_block("frame_params", frame_params_binding);
+        return program;
+    };
+    frame_params params{};
+    params.resolution = {opts.width, opts.height};
+    params.time       = 1.5f;
+    mno::uniform_buffer params_buffer{sizeof(frame_params), frame_params_binding};
+    params_buffer.update(params);
+
+    auto const pixels = mno::f64(opts.width) * mno::f64(opts.height);
+    auto const target_bytes = std::size_t(opts.width) * std::size_t(opts.height);
+
+    // Koch3D raymarch from a fixed camera, time pins the animation
+    auto koch = load("./shaders/410.koch3d.gl.frag");
+    mno::framebuffer target{opts.width, opts.height};
+    b.run("koch3d/fixed_camera", "gpu", target_bytes * 4, [&] {
+        target.bind();
+        glViewport(0, 0, opts.width, opts.height);
+        koch->bind();
+        graphics->draw_triangles(quad);
+        target.unbind();
+        glFinish();
+        return frame_work{pixels, 0.0};
+    });
+
+    // Escape-time Mandelbrot in f32, the view goes in through frame_params.
+    // The deepest scene sits where a pixel is about one f32 ulp of the centre.
+    struct scene {
+        char const*   name;
+        glm::vec2     center;
+        mno::f32      scale;
+        std::uint32_t max_iterations;
+    };
+    glm::vec2 const seahorse{-0.743643887f, 0.131825904f};
+    auto const float_limit = std::max(std::abs(seahorse.x), std::abs(seahorse.y)) *
+                             std::numeric_limits<mno::f32>::epsilon() * mno::f32(opts.width);
+    scene const scenes[]{
+        {"mandelbrot/gl_overview",    {-0.5f, 0.0f}, 3.0f,        256},
+        {"mandelbrot/gl_seahorse_1e-4", seahorse,    1e-4f,       1024},
+        {"mandelbrot/gl_float_limit",   seahorse,    float_limit, 4096},
+    };
+    auto mandelbrot = load("./shaders/410.mandelbrot.gl.frag");
+    for (auto const& s : scenes) {
+        b.run(s.name, "gpu", target_bytes * 4, [&] {
+            params.location = s.center;
+            params.zoom     = s.scale;
+            params_buffer.update(params);
+            target.bind();
+            glViewport(0, 0, opts.width, opts.height);
+            mandelbrot->bind();
+            mandelbrot->num("u_max_iterations", mno::f32(s.max_iterations));
+            graphics->draw_triangles(quad);
+            target.unbind();
+            glFinish();
+            return frame_work{pixels, 0.0};
+        });
+    }
+    params.location = {0.0f, 0.0f};
+    params.zoom     = 1.0f;
+    params_buffer.update(params);
+
+    // GPU Conway, 16 generations per frame on ping-pong R8 targets
+    constexpr std::int32_t generations = 16;
+    auto conway = load("./shaders/410.conway.gl.frag");
+    auto noise  = load("./shaders/410.noise.gl.frag");
+    mno::double_buffered_target life_target{opts.width, opts.height};
+    life_target.back().bind();
+    glViewport(0, 0, opts.width, opts.height);
+    noise->bind();
+    noise->num("u_seed_lo", mno::u32(1));
+    noise->num("u_seed_hi", mno::u32(0));
+    noise->num("u_threshold", mno::random_threshold(0.5f));
+    noise->num("u_width", mno::i32(opts.width));
+    graphics->draw_triangles(quad);
+    life_target.swap();
+    life_target.front().unbind();
+    b.run("conway/gpu_16", "gpu", target_bytes * 2, [&] {
+        life_target.run(generations, 1, [&] {
+            conway->bind();
+            conway->num("u_texture1", 1);
+            graphics->draw_triangles(quad);
+        });
+        glFinish();
+        return frame_work{pixels * generations, pixels * generations};
+    });
+}
+}  // namespace nrv
+
+auto main(std::int32_t argc, char const* argv[]) -> std::int32_t {
+    // Progress on stderr keeps stdout clean for the JSON
+    spdlog::set_default_logger(spdlog::stderr_color_mt("bench"));
+    auto const options = nrv::parse_options(argc, argv);
+
+    nrv::bench b{options};
+    mno::tile_scheduler scheduler{};
+    b.set_machine("simd", mno::to_string(mno::cpu_simd_level()));
+    b.set_machine("threads", std::to_string(scheduler.thread_count()));
+
+    nrv::run_mandelbrot(b, options, scheduler);
+    nrv::run_life(b, scheduler);
+    if (options.gpu) {
+        try {
+            nrv::run_gpu(b, options);
+        } catch (std::runtime_error const& error) {
+            spdlog::warn("Skipping GPU scenes: {}", error.what());
+        }
+    }
+
+    if (options.output.empty()) {
+        std::cout << b.json();
+    } else {
+        std::ofstream output{options.output};
+        if (!output.is_open()) {
+            spdlog::error("Failed writing {}", options.output);
+            return 1;
+        }
+        output << b.json();
+        spdlog::info("Wrote {}", options.output);
+    }
+    return 0;
+}
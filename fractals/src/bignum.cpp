@@ -0,0 +1,214 @@
+/**
+ * @file   bignum.cpp
+ * @author Pratchaya Khansomboon (me@mononerv.dev)
+ * @brief  Small arbitrary precision fixed-point number for reference orbits.
+ * @date   2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ */
+#include "bignum.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace nrv {
+auto bignum::limbs_for_bits(std::uint32_t const& bits) -> std::size_t {
+    return std::size_t((bits + 31) / 32) + 1;
+}
+
+bignum::bignum(std::size_t const& limbs) : m_limbs(std::max(limbs, std::size_t(2)), 0) {}
+
+bignum::bignum(mno::f64 const& value, std::size_t const& limbs) : bignum(limbs) {
+    auto magnitude = std::abs(value);
+    if (!(magnitude < 4294967296.0)) throw std::invalid_argument("bignum: value out of range");
+    m_negative = value < 0.0;
+
+    auto const integer = std::floor(magnitude);
+    m_limbs.back() = static_cast<std::uint32_t>(integer);
+    magnitude -= integer;
+    // Peel off 32 bits at a time, exact since every step only shifts the mantissa
+    for (auto i = m_limbs.size() - 1; i-- > 0 && magnitude > 0.0;) {
+        magnitude *= 4294967296.0;
+        auto const limb = std::floor(magnitude);
+        m_limbs[i] = static_cast<std::uint32_t>(limb);
+        magnitude -= limb;
+    }
+    if (is_zero()) m_negative = false;
+}
+
+bignum::bignum(std::string const& value, std::size_t const& limbs) : bignum(limbs) {
+    std::size_t i = 0;
+    auto negative = false;
+    if (i < value.size() && (value[i] == '-' || value[i] == '+')) negative = value[i++] == '-';
+
+    std::uint64_t integer = 0;
+    auto digits = 0;
+    for (; i < value.size() && value[i] >= '0' && value[i] <= '9'; i++, digits++) {
+        integer = integer * 10 + std::uint64_t(value[i] - '0');
+        if (integer > 0xFFFFFFFFull) throw std::invalid_argument("bignum: value out of range");
+    }
+
+    auto const fraction_begin = i < value.size() && value[i] == '.' ? ++i : i;
+    for (; i < value.size() && value[i] >= '0' && value[i] <= '9'; i++, digits++);
+    if (digits == 0 || i != value.size()) throw std::invalid_argument("bignum: invalid number \"" + value + "\"");
+
+    // Horner from the last fraction digit: x = (d + x) / 10. The divisions
+    // truncate, exact truncates to a guard limb below the last one and bit 31
+    // of the guard tells whether the rest is at least half of the last limb.
+    bignum exact(m_limbs.size() + 1);
+    for (auto j = i; j-- > fraction_begin;) {
+        exact.m_limbs.back() = std::uint32_t(value[j] - '0');
+        exact.divide_small(10);
+    }
+    std::uint64_t carry = exact.m_limbs[0] >> 31;
+    for (std::size_t k = 0; k + 1 < m_limbs.size(); k++) {
+        auto const t = std::uint64_t(exact.m_limbs[k + 1]) + carry;
+        m_limbs[k] = static_cast<std::uint32_t>(t);
+        carry      = t >> 32;
+    }
+    if (integer + carry > 0xFFFFFFFFull) throw std::invalid_argument("bignum: value out of range");
+    m_limbs.back() = static_cast<std::uint32_t>(integer + carry);
+    m_negative = negative && !is_zero();
+}
+
+auto bignum::is_zero() const -> bool {
+    return std::all_of(std::begin(m_limbs), std::end(m_limbs), [](auto const& limb) { return limb == 0; });
+}
+
+auto bignum::to_f64() const -> mno::f64 {
+    mno::f64 value = 0.0;
+    mno::f64 scale = 1.0;
+    for (auto i = m_limbs.size(); i-- > 0;) {
+        value += mno::f64(m_limbs[i]) * scale;
+        scale *= 1.0 / 4294967296.0;
+    }
+    return m_negative ? -value : value;
+}
+
+auto bignum::str() const -> std::string {
+    auto fraction = *this;
+    fraction.m_limbs.back() = 0;
+    // One digit more than the fraction bits carry, so the decimal is closer
+    // than half a unit in the last limb and parses back to the same value
+    auto const digits = std::size_t(mno::f64(32 * (m_limbs.size() - 1)) * 0.30102999566398120) + 1;
+    std::string decimals(digits, '0');
+    for (auto& digit : decimals) {
+        std::uint64_t carry = 0;
+        for (auto& limb : fraction.m_limbs) {
+            auto const t = std::uint64_t(limb) * 10 + carry;
+            limb  = static_cast<std::uint32_t>(t);
+            carry = t >> 32;
+        }
+        digit = char('0' + fraction.m_limbs.back());
+        fraction.m_limbs.back() = 0;
+    }
+
+    // Round half up at the last digit, what is left is below one digit
+    auto integer = std::uint64_t(m_limbs.back());
+    if (fraction.m_limbs[fraction.m_limbs.size() - 2] >> 31) {
+        auto d = decimals.size();
+        while (d > 0 && decimals[d - 1] == '9') decimals[--d] = '0';
+        if (d > 0) decimals[d - 1]++;
+        else integer++;
+    }
+    return (m_negative ? "-" : "") + std::to_string(integer) + "." + decimals;
+}
+
+auto bignum::operator+(bignum const& rhs) const -> bignum {
+    check_limbs(rhs);
+    if (m_negative == rhs.m_negative) {
+        auto result = add_magnitude(*this, rhs);
+        result.m_negative = m_negative && !result.is_zero();
+        return result;
+    }
+    if (compare_magnitude(*this, rhs) >= 0) {
+        auto result = sub_magnitude(*this, rhs);
+        result.m_negative = m_negative && !result.is_zero();
+        return result;
+    }
+    auto result = sub_magnitude(rhs, *this);
+    result.m_negative = rhs.m_negative && !result.is_zero();
+    return result;
+}
+
+auto bignum::operator-(bignum const& rhs) const -> bignum {
+    return *this + (-rhs);
+}
+
+auto bignum::operator-() const -> bignum {
+    auto result = *this;
+    result.m_negative = !m_negative && !is_zero();
+    return result;
+}
+
+// The result is truncated back to the same fixed-point format.
+auto bignum::operator*(bignum const& rhs) const -> bignum {
+    check_limbs(rhs);
+    auto const n = m_limbs.size();
+    std::vector<std::uint32_t> product(n * 2, 0);
+    for (std::size_t i = 0; i < n; i++) {
+        std::uint64_t carry = 0;
+        auto const a = std::uint64_t(m_limbs[i]);
+        if (a == 0) continue;
+        for (std::size_t j = 0; j < n; j++) {
+            auto const t = a * rhs.m_limbs[j] + product[i + j] + carry;
+            product[i + j] = static_cast<std::uint32_t>(t);
+            carry = t >> 32;
+        }
+        product[i + n] = static_cast<std::uint32_t>(carry);
+    }
+
+    if (product.back() != 0) throw std::overflow_error("bignum: product out of range");
+    bignum result{n};
+    std::copy_n(std::begin(product) + std::ptrdiff_t(n - 1), n, std::begin(result.m_limbs));
+    result.m_negative = m_negative != rhs.m_negative && !result.is_zero();
+    return result;
+}
+
+auto bignum::check_limbs(bignum const& rhs) const -> void {
+    if (m_limbs.size() != rhs.m_limbs.size())
+        throw std::invalid_argument("bignum: operands have " + std::to_string(m_limbs.size()) + " and " +
+                                    std::to_string(rhs.m_limbs.size()) + " limbs");
+}
+
+auto bignum::compare_magnitude(bignum const& a, bignum const& b) -> std::int32_t {
+    for (auto i = a.m_limbs.size(); i-- > 0;) {
+        if (a.m_limbs[i] != b.m_limbs[i]) return a.m_limbs[i] < b.m_limbs[i] ? -1 : 1;
+    }
+    return 0;
+}
+
+auto bignum::add_magnitude(bignum const& a, bignum const& b) -> bignum {
+    bignum result{a.m_limbs.size()};
+    std::uint64_t carry = 0;
+    for (std::size_t i = 0; i < a.m_limbs.size(); i++) {
+        auto const t = std::uint64_t(a.m_limbs[i]) + b.m_limbs[i] + carry;
+        result.m_limbs[i] = static_cast<std::uint32_t>(t);
+        carry = t >> 32;
+    }
+    if (carry != 0) throw std::overflow_error("bignum: sum out of range");
+    return result;
+}
+
+auto bignum::sub_magnitude(bignum const& a, bignum const& b) -> bignum {
+    bignum result{a.m_limbs.size()};
+    std::int64_t borrow = 0;
+    for (std::size_t i = 0; i < a.m_limbs.size(); i++) {
+        auto t = std::int64_t(a.m_limbs[i]) - std::int64_t(b.m_limbs[i]) - borrow;
+        borrow = t < 0 ? 1 : 0;
+        if (t < 0) t += 4294967296ll;
+        result.m_limbs[i] = static_cast<std::uint32_t>(t);
+    }
+    return result;
+}
+
+auto bignum::divide_small(std::uint32_t const& divisor) -> void {
+    std::uint64_t remainder = 0;
+    for (auto i = m_limbs.size(); i-- > 0;) {
+        auto const current = remainder << 32 | m_limbs[i];
+        m_limbs[i] = static_cast<std::uint32_t>(current / divisor);
+        remainder  = current % divisor;
+    }
+}
+}  // namespace nrv
@@ -0,0 +1,62 @@
+/**
+ * @file   bignum.hpp
+ * @author Pratchaya Khansomboon (me@mononerv.dev)
+ * @brief  Small arbitrary precision fixed-point number for reference orbits.
+ * @date   2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ */
+#ifndef NRV_BIGNUM_HPP
+#define NRV_BIGNUM_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "mono/common.hpp"
+
+namespace nrv {
+// Sign-magnitude fixed-point number. Limbs are little endian 32-bit words,
+// the last limb holds the integer part and the rest are fraction, so the
+// range is |x| < 2^32 which is plenty for Mandelbrot orbits.
+class bignum {
+  public:
+    // Number of limbs needed for bits of fraction, plus the integer limb.
+    static auto limbs_for_bits(std::uint32_t const& bits) -> std::size_t;
+
+  public:
+    explicit bignum(std::size_t const& limbs = 2);
+    bignum(mno::f64 const& value, std::size_t const& limbs);
+    // Parses decimal strings like "-1.7497591451303665" rounded to the nearest
+    // representable value, throws std::invalid_argument.
+    bignum(std::string const& value, std::size_t const& limbs);
+
+    auto limbs() const -> std::size_t { return m_limbs.size(); }
+    auto is_negative() const -> bool { return m_negative; }
+    auto is_zero() const -> bool;
+    auto to_f64() const -> mno::f64;
+    // Decimal with enough digits to parse back to the same value, the last
+    // digit rounded half up.
+    [[nodiscard]] auto str() const -> std::string;
+
+    // Operands must have the same number of limbs and results must stay in
+    // range, otherwise these throw std::invalid_argument and std::overflow_error.
+    auto operator+(bignum const& rhs) const -> bignum;
+    auto operator-(bignum const& rhs) const -> bignum;
+    auto operator*(bignum const& rhs) const -> bignum;
+    auto operator-() const -> bignum;
+
+  private:
+    auto check_limbs(bignum const& rhs) const -> void;
+    static auto compare_magnitude(bignum const& a, bignum const& b) -> std::int32_t;
+    static auto add_magnitude(bignum const& a, bignum const& b) -> bignum;
+    static auto sub_magnitude(bignum const& a, bignum const& b) -> bignum;  // requires |a| >= |b|
+    auto divide_small(std::uint32_t const& divisor) -> void;
+
+  private:
+    bool                       m_negative{false};
+    std::vector<std::uint32_t> m_limbs;
+};
+}  // namespace nrv
+
+#endif // NRV_BIGNUM_HPP
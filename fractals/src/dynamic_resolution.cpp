@@ -0,0 +1,97 @@
+/**
+ * @file   dynamic_resolution.cpp
+ * @author Pratchaya Khansomboon (me@mononerv.dev)
+ * @brief  Render scale and step budget controller driven by GPU frame time.
+ * @date   2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ */
+#include "dynamic_resolution.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace nrv {
+// Measurements between this fraction of the target and the target are kept
+static constexpr mno::f64 dead_band = 0.7;
+
+dynamic_resolution::dynamic_resolution(dynamic_resolution_settings const& settings)
+    : m_settings(settings), m_scale(1.0f), m_steps(settings.max_steps),
+      m_interactive_scale(1.0f), m_interactive_steps(settings.max_steps) {}
+
+auto dynamic_resolution::update(std::uint64_t const& frame, bool const& is_moving,
+                                mno::profiler::frame_timing const& latest) -> void {
+    if (is_moving) {
+        m_still_frames = 0;
+        m_is_final     = false;
+        if (m_is_refined) {
+            m_is_refined = false;
+            set(frame, m_interactive_scale, m_interactive_steps);
+        }
+        measure(frame, latest);
+        return;
+    }
+    if (m_is_refined) return;
+    if (++m_still_frames < m_settings.settle_frames) {
+        measure(frame, latest);
+        return;
+    }
+    m_interactive_scale = m_scale;
+    m_interactive_steps = m_steps;
+    m_is_refined        = true;
+    set(frame, 1.0f, m_settings.max_steps);
+}
+
+auto dynamic_resolution::render_size(std::int32_t const& width, std::int32_t const& height) const
+    -> std::pair<std::int32_t, std::int32_t> {
+    auto const w = std::int32_t(std::lround(mno::f32(width) * m_scale));
+    auto const h = std::int32_t(std::lround(mno::f32(height) * m_scale));
+    return {std::max(w, 1), std::max(h, 1)};
+}
+
+auto dynamic_resolution::set(std::uint64_t const& frame, mno::f32 const& scale, std::int32_t const& steps) -> void {
+    if (scale == m_scale && steps == m_steps) return;
+    m_scale      = scale;
+    m_steps      = steps;
+    m_changed_at = frame;
+    m_is_final   = false;
+}
+
+auto dynamic_resolution::measure(std::uint64_t const& frame, mno::profiler::frame_timing const& latest) -> void {
+    if (!latest.has_gpu || latest.frame < m_changed_at || latest.frame < m_measured) return;
+    m_measured = latest.frame + 1;
+
+    auto const pass = std::find_if(std::begin(latest.passes), std::end(latest.passes), [&](auto const& timing) {
+        return timing.name == m_settings.pass && !std::isnan(timing.gpu_ms);
+    });
+    if (pass == std::end(latest.passes) || pass->gpu_ms <= 0.0) return;
+    auto const target = m_settings.target_ms;
+    if (pass->gpu_ms <= target && pass->gpu_ms >= target * dead_band) return;
+
+    // Relative cost of the measured frame scaled to what fits the budget
+    auto const max_steps = mno::f64(m_settings.max_steps);
+    auto const cost      = mno::f64(m_scale) * mno::f64(m_scale) * mno::f64(m_steps) / max_steps;
+    auto const budget    = std::min(cost * target / pass->gpu_ms, 1.0);
+
+    // Rounded down to whole scale steps so the result stays within budget
+    auto const step  = mno::f64(m_settings.scale_step);
+    auto const min   = mno::f64(m_settings.min_scale);
+    auto const ideal = std::sqrt(budget);
+    if (ideal >= min) {
+        auto const scale = std::clamp(std::floor(ideal / step + 1e-4) * step, min, 1.0);
+        set(frame, mno::f32(scale), m_settings.max_steps);
+        return;
+    }
+    auto const steps = std::int32_t(budget / (min * min) * max_steps);
+    set(frame, m_settings.min_scale, std::clamp(steps, m_settings.min_steps, m_settings.max_steps));
+}
+
+auto dynamic_resolution::str() const -> std::string {
+    std::string str{"nrv::dynamic_resolution { "};
+    str += "scale: " + std::to_string(m_scale) + ", ";
+    str += "max_steps: " + std::to_string(m_steps) + ", ";
+    str += "target_ms: " + std::to_string(m_settings.target_ms) + ", ";
+    str += "refined: " + std::string(m_is_refined ? "true" : "false") + " }";
+    return str;
+}
+}  // namespace nrv
@@ -0,0 +1,83 @@
+/**
+ * @file   dynamic_resolution.hpp
+ * @author Pratchaya Khansomboon (me@mononerv.dev)
+ * @brief  Render scale and step budget controller driven by GPU frame time.
+ * @date   2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ */
+#ifndef NRV_DYNAMIC_RESOLUTION_HPP
+#define NRV_DYNAMIC_RESOLUTION_HPP
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "mono/common.hpp"
+#include "mono/profiler.hpp"
+
+namespace nrv {
+struct dynamic_resolution_settings {
+    std::string_view pass          = "koch3d";  // profiler pass whose GPU time is budgeted
+    mno::f64         target_ms     = 12.0;      // GPU budget of the pass per frame
+    mno::f32         min_scale     = 0.25f;
+    mno::f32         scale_step    = 0.125f;    // scales are multiples of this, limits target resizes
+    std::int32_t     min_steps     = 32;
+    std::int32_t     max_steps     = 100;       // MAX_STEPS of the shader
+    std::uint32_t    settle_frames = 8;         // still frames before refining
+};
+
+// Picks the render scale and ray march step budget of a raymarched pass so
+// its GPU time stays within target_ms while the camera moves. The cost is
+// modelled as scale^2 * steps, every measurement rescales it by target over
+// measured time. Steps are only cut once the scale is at its minimum, fewer
+// pixels blur the image but fewer steps punch holes into it.
+//
+// Measurements arrive a few frames late through the profiler, those of
+// frames rendered before the last change are skipped so the controller
+// doesn't react twice to the same cost. Once the camera has been still for
+// settle_frames the pass is refined to full resolution and steps, rendered
+// a single time and then reused until the camera moves or invalidate().
+class dynamic_resolution {
+  public:
+    explicit dynamic_resolution(dynamic_resolution_settings const& settings = {});
+    ~dynamic_resolution() = default;
+
+    // Call once per frame before rendering, frame is the profiler's current frame.
+    auto update(std::uint64_t const& frame, bool const& is_moving, mno::profiler::frame_timing const& latest) -> void;
+    // Size of the render target for a width x height output.
+    auto render_size(std::int32_t const& width, std::int32_t const& height) const -> std::pair<std::int32_t, std::int32_t>;
+    // False when the refined frame from an earlier call is still valid.
+    auto needs_render() const -> bool { return !m_is_final; }
+    auto rendered() -> void { m_is_final = is_refined(); }
+    // Scene changed without the camera moving, e.g. a shader reload.
+    auto invalidate() -> void { m_is_final = false; }
+
+    auto scale() const -> mno::f32 { return m_scale; }
+    auto max_steps() const -> std::int32_t { return m_steps; }
+    auto is_refined() const -> bool { return m_is_refined; }
+    auto settings() const -> dynamic_resolution_settings const& { return m_settings; }
+
+    [[nodiscard]] auto str() const -> std::string;
+
+  private:
+    auto set(std::uint64_t const& frame, mno::f32 const& scale, std::int32_t const& steps) -> void;
+    auto measure(std::uint64_t const& frame, mno::profiler::frame_timing const& latest) -> void;
+
+  private:
+    dynamic_resolution_settings m_settings;
+    mno::f32                    m_scale;
+    std::int32_t                m_steps;
+
+    bool                        m_is_refined{false};
+    bool                        m_is_final{false};
+    mno::f32                    m_interactive_scale;  // restored when the camera moves after refining
+    std::int32_t                m_interactive_steps;
+    std::uint32_t               m_still_frames{0};
+    std::uint64_t               m_changed_at{0};      // first frame rendered with the current settings
+    std::uint64_t               m_measured{0};        // next frame whose measurement is new
+};
+}  // namespace nrv
+
+#endif // NRV_DYNAMIC_RESOLUTION_HPP
@@ -0,0 +1,34 @@
+/**
+ * @file   frame_params.hpp
+ * @author Pratchaya Khansomboon (me@mononerv.dev)
+ * @brief  Per-frame shader parameters shared through a uniform buffer.
+ * @date   2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ */
+#ifndef NRV_FRAME_PARAMS_HPP
+#define NRV_FRAME_PARAMS_HPP
+
+#include <cstdint>
+
+#include "mono/common.hpp"
+#include "glm/vec2.hpp"
+
+namespace nrv {
+// Uniform buffer binding point of the frame_params block.
+inline constexpr std::uint32_t frame_params_binding = 0;
+
+// Mirrors the std140 frame_params block declared in the fragment shaders,
+// vec2 members are 8 byte aligned and the block is padded to 16 bytes.
+struct alignas(16) frame_params {
+    glm::vec2     resolution{0.0f};
+    glm::vec2     mouse{0.0f};
+    glm::vec2     location{0.0f};
+    mno::f32      time{0.0f};
+    mno::f32      zoom{1.0f};
+    std::uint32_t frame{0};
+};
+static_assert(sizeof(frame_params) == 48, "frame_params must match the std140 block layout");
+}  // namespace nrv
+
+#endif // NRV_FRAME_PARAMS_HPP
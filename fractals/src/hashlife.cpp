@@ -0,0 +1,312 @@
+/**
+ * @file   hashlife.cpp
+ * @author Pratchaya Khansomboon (me@mononerv.dev)
+ * @brief  HashLife, memoized quadtree Game of Life for very long runs.
+ * @date   2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ */
+#include "hashlife.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace nrv {
+hashlife::hashlife() {
+    clear();
+}
+
+auto hashlife::clear() -> void {
+    m_nodes.clear();
+    m_empty.clear();
+    // Leaves are the dead and alive cell, they never go in the table
+    m_nodes.push_back({0, 0, 0, 0, invalid_node, 0, 0, 0});
+    m_nodes.push_back({0, 0, 0, 0, invalid_node, 0, 0, 1});
+    m_empty.push_back(0);
+    rehash(1024);
+    m_root = empty(3);
+    m_generation = 0;
+}
+
+auto hashlife::get(std::int64_t const& x, std::int64_t const& y) const -> bool {
+    if (!fits(x, y)) return false;
+    auto index = m_root;
+    auto const half = std::int64_t(1) << (m_nodes[m_root].level - 1);
+    auto rx = std::uint64_t(x + half);
+    auto ry = std::uint64_t(y + half);
+    for (auto level = m_nodes[m_root].level; level > 0; level--) {
+        auto const& n = m_nodes[index];
+        if (n.population == 0) return false;
+        auto const shift = level - 1u;
+        auto const east  = (rx >> shift) & 1;
+        auto const south = (ry >> shift) & 1;
+        index = south ? (east ? n.se : n.sw) : (east ? n.ne : n.nw);
+    }
+    return index == 1;
+}
+
+auto hashlife::set(std::int64_t const& x, std::int64_t const& y, bool const& alive) -> void {
+    while (!fits(x, y)) {
+        if (m_nodes[m_root].level >= max_level) throw std::out_of_range("hashlife: coordinate out of range");
+        m_root = expand(m_root);
+    }
+    auto const half = std::int64_t(1) << (m_nodes[m_root].level - 1);
+    m_root = set(m_root, std::uint64_t(x + half), std::uint64_t(y + half), alive);
+}
+
+auto hashlife::set(std::uint32_t const& index, std::uint64_t const& x, std::uint64_t const& y,
+                   bool const& alive) -> std::uint32_t {
+    auto const n = m_nodes[index];
+    if (n.level == 0) return alive ? 1 : 0;
+    auto const shift = n.level - 1u;
+    auto const mask  = (std::uint64_t(1) << shift) - 1;
+    auto const east  = (x >> shift) & 1;
+    auto const south = (y >> shift) & 1;
+    if (!south && !east) return join(set(n.nw, x & mask, y & mask, alive), n.ne, n.sw, n.se);
+    if (!south &&  east) return join(n.nw, set(n.ne, x & mask, y & mask, alive), n.sw, n.se);
+    if ( south && !east) return join(n.nw, n.ne, set(n.sw, x & mask, y & mask, alive), n.se);
+    return join(n.nw, n.ne, n.sw, set(n.se, x & mask, y & mask, alive));
+}
+
+auto hashlife::fits(std::int64_t const& x, std::int64_t const& y) const -> bool {
+    auto const half = std::int64_t(1) << (m_nodes[m_root].level - 1);
+    return x >= -half && x < half && y >= -half && y < half;
+}
+
+auto hashlife::step(std::uint32_t const& log2_generations) -> void {
+    if (log2_generations + 3 > max_level) throw std::out_of_range("hashlife: step too large");
+    // The successor is the centre half of the root, so the pattern must sit
+    // in the centre quarter to have room to grow by 2^k cells each way.
+    while (m_nodes[m_root].level < log2_generations + 2 || !is_padded(m_root))
+        m_root = expand(m_root);
+    m_root = expand(m_root);
+    m_root = successor(m_root, log2_generations);
+    m_generation += std::uint64_t(1) << log2_generations;
+
+    if (m_nodes.size() > m_gc_threshold) {
+        collect();
+        // Mostly live nodes, collecting again soon would only waste time
+        if (m_nodes.size() > m_gc_threshold / 2) m_gc_threshold *= 2;
+    }
+}
+
+auto hashlife::successor(std::uint32_t const& index, std::uint32_t const& step) -> std::uint32_t {
+    auto const n = m_nodes[index];
+    auto const effective = std::min(step, n.level - 2u);
+    if (n.result != invalid_node && n.result_step == effective) return n.result;
+
+    std::uint32_t result;
+    if (n.population == 0) {
+        result = n.nw;
+    } else if (n.level == 2) {
+        result = successor_base(index);
+    } else {
+        // Nine overlapping squares of half the size covering the node
+        std::uint32_t const c[9]{
+            n.nw,                          centre_horizontal(n.nw, n.ne), n.ne,
+            centre_vertical(n.nw, n.sw),   centre(index),                 centre_vertical(n.ne, n.se),
+            n.sw,                          centre_horizontal(n.sw, n.se), n.se,
+        };
+        // At full speed both halves advance 2^(level - 3), otherwise the first
+        // half only crops and the second half advances the whole step.
+        auto const is_full = effective == n.level - 2u;
+        auto const half    = n.level - 3u;
+        std::uint32_t r[9];
+        for (std::size_t i = 0; i < 9; i++) r[i] = is_full ? successor(c[i], half) : centre(c[i]);
+
+        auto const next = is_full ? half : effective;
+        result = join(successor(join(r[0], r[1], r[3], r[4]), next),
+                      successor(join(r[1], r[2], r[4], r[5]), next),
+                      successor(join(r[3], r[4], r[6], r[7]), next),
+                      successor(join(r[4], r[5], r[7], r[8]), next));
+    }
+    m_nodes[index].result      = result;
+    m_nodes[index].result_step = std::uint8_t(effective);
+    return result;
+}
+
+// A 4x4 node advanced one generation, the rules run on a 16-bit mask.
+auto hashlife::successor_base(std::uint32_t const& index) -> std::uint32_t {
+    auto const& n = m_nodes[index];
+    std::uint32_t const quadrants[4]{n.nw, n.ne, n.sw, n.se};
+    std::uint32_t cells = 0;
+    for (std::uint32_t q = 0; q < 4; q++) {
+        auto const& quadrant = m_nodes[quadrants[q]];
+        std::uint32_t const leaves[4]{quadrant.nw, quadrant.ne, quadrant.sw, quadrant.se};
+        for (std::uint32_t l = 0; l < 4; l++) {
+            auto const x = (q & 1) * 2 + (l & 1);
+            auto const y = (q >> 1) * 2 + (l >> 1);
+            cells |= leaves[l] << (y * 4 + x);
+        }
+    }
+
+    auto next = [&](std::uint32_t const& x, std::uint32_t const& y) -> std::uint32_t {
+        std::uint32_t count = 0;
+        for (std::uint32_t dy = y - 1; dy <= y + 1; dy++)
+            for (std::uint32_t dx = x - 1; dx <= x + 1; dx++)
+                count += (cells >> (dy * 4 + dx)) & 1;
+        auto const alive = (cells >> (y * 4 + x)) & 1;
+        count -= alive;
+        return count == 3 || (count == 2 && alive) ? 1 : 0;
+    };
+    return join(next(1, 1), next(2, 1), next(1, 2), next(2, 2));
+}
+
+auto hashlife::join(std::uint32_t const& nw, std::uint32_t const& ne,
+                    std::uint32_t const& sw, std::uint32_t const& se) -> std::uint32_t {
+    auto const mask = m_table.size() - 1;
+    auto slot = std::size_t(hash(nw, ne, sw, se)) & mask;
+    for (; m_table[slot] != invalid_node; slot = (slot + 1) & mask) {
+        auto const& n = m_nodes[m_table[slot]];
+        if (n.nw == nw && n.ne == ne && n.sw == sw && n.se == se) return m_table[slot];
+    }
+
+    if (m_nodes.size() >= invalid_node - 1) throw std::length_error("hashlife: out of node indices");
+    auto const index = std::uint32_t(m_nodes.size());
+    auto const population = m_nodes[nw].population + m_nodes[ne].population +
+                            m_nodes[sw].population + m_nodes[se].population;
+    m_nodes.push_back({nw, ne, sw, se, invalid_node, std::uint8_t(m_nodes[nw].level + 1), 0, population});
+    m_table[slot] = index;
+    // Keep the load factor under a half so probe chains stay short
+    if (m_nodes.size() * 2 > m_table.size()) rehash(m_table.size() * 2);
+    return index;
+}
+
+auto hashlife::empty(std::uint32_t const& level) -> std::uint32_t {
+    while (m_empty.size() <= level) {
+        auto const e = m_empty.back();
+        m_empty.push_back(join(e, e, e, e));
+    }
+    return m_empty[level];
+}
+
+auto hashlife::expand(std::uint32_t const& index) -> std::uint32_t {
+    auto const n = m_nodes[index];
+    auto const e = empty(n.level - 1u);
+    return join(join(e, e, e, n.nw), join(e, e, n.ne, e),
+                join(e, n.sw, e, e), join(n.se, e, e, e));
+}
+
+auto hashlife::is_padded(std::uint32_t const& index) const -> bool {
+    auto const& n = m_nodes[index];
+    if (n.level < 3) return n.population == 0;
+    return m_nodes[n.nw].population == m_nodes[m_nodes[n.nw].se].population &&
+           m_nodes[n.ne].population == m_nodes[m_nodes[n.ne].sw].population &&
+           m_nodes[n.sw].population == m_nodes[m_nodes[n.sw].ne].population &&
+           m_nodes[n.se].population == m_nodes[m_nodes[n.se].nw].population;
+}
+
+auto hashlife::centre(std::uint32_t const& index) -> std::uint32_t {
+    auto const n = m_nodes[index];
+    return join(m_nodes[n.nw].se, m_nodes[n.ne].sw, m_nodes[n.sw].ne, m_nodes[n.se].nw);
+}
+
+auto hashlife::centre_horizontal(std::uint32_t const& w, std::uint32_t const& e) -> std::uint32_t {
+    auto const a = m_nodes[w];
+    auto const b = m_nodes[e];
+    return join(a.ne, b.nw, a.se, b.sw);
+}
+
+auto hashlife::centre_vertical(std::uint32_t const& n, std::uint32_t const& s) -> std::uint32_t {
+    auto const a = m_nodes[n];
+    auto const b = m_nodes[s];
+    return join(a.sw, a.se, b.nw, b.ne);
+}
+
+auto hashlife::hash(std::uint32_t const& nw, std::uint32_t const& ne,
+                    std::uint32_t const& sw, std::uint32_t const& se) -> std::uint64_t {
+    auto h = (std::uint64_t(nw) << 32 | ne) * 0x9E3779B97F4A7C15ull;
+    h ^= (std::uint64_t(sw) << 32 | se) * 0xC2B2AE3D27D4EB4Full;
+    return h ^ (h >> 29);
+}
+
+auto hashlife::rehash(std::size_t const& size) -> void {
+    m_table.assign(size, invalid_node);
+    auto const mask = size - 1;
+    for (std::size_t i = 2; i < m_nodes.size(); i++) {
+        auto const& n = m_nodes[i];
+        auto slot = std::size_t(hash(n.nw, n.ne, n.sw, n.se)) & mask;
+        while (m_table[slot] != invalid_node) slot = (slot + 1) & mask;
+        m_table[slot] = std::uint32_t(i);
+    }
+}
+
+auto hashlife::collect() -> void {
+    std::vector<std::uint8_t> marked(m_nodes.size(), 0);
+    std::vector<std::uint32_t> stack{m_root};
+    stack.insert(std::end(stack), std::begin(m_empty), std::end(m_empty));
+    marked[0] = marked[1] = 1;
+    while (!stack.empty()) {
+        auto const index = stack.back();
+        stack.pop_back();
+        if (marked[index]) continue;
+        marked[index] = 1;
+        auto const& n = m_nodes[index];
+        stack.insert(std::end(stack), {n.nw, n.ne, n.sw, n.se});
+    }
+
+    // Children are always created before their parents, compacting in order
+    // keeps that true. Results can point forward so they are remapped after.
+    std::vector<std::uint32_t> remap(m_nodes.size(), invalid_node);
+    std::uint32_t count = 0;
+    for (std::size_t i = 0; i < m_nodes.size(); i++)
+        if (marked[i]) remap[i] = count++;
+
+    std::vector<node> nodes;
+    nodes.reserve(count);
+    for (std::size_t i = 0; i < m_nodes.size(); i++) {
+        if (!marked[i]) continue;
+        auto n = m_nodes[i];
+        if (n.level > 0) {
+            n.nw = remap[n.nw];
+            n.ne = remap[n.ne];
+            n.sw = remap[n.sw];
+            n.se = remap[n.se];
+        }
+        n.result = n.result != invalid_node ? remap[n.result] : invalid_node;
+        nodes.push_back(n);
+    }
+    m_nodes = std::move(nodes);
+    m_root  = remap[m_root];
+    for (auto& e : m_empty) e = remap[e];
+
+    auto size = std::size_t(1024);
+    while (size < m_nodes.size() * 2) size *= 2;
+    rehash(size);
+}
+
+auto hashlife::render(mno::image& image, std::int64_t const& x0, std::int64_t const& y0) const -> void {
+    for (std::int32_t y = 0; y < image.height(); y++)
+        for (std::int32_t x = 0; x < image.width(); x++)
+            image.set(x, y, 0x000000);
+    auto const half = std::int64_t(1) << (m_nodes[m_root].level - 1);
+    render(image, m_root, -half, -half, x0, y0);
+}
+
+auto hashlife::render(mno::image& image, std::uint32_t const& index, std::int64_t const& x, std::int64_t const& y,
+                      std::int64_t const& x0, std::int64_t const& y0) const -> void {
+    auto const& n = m_nodes[index];
+    if (n.population == 0) return;
+    auto const size = std::int64_t(1) << n.level;
+    // Skip squares that don't overlap the view at all
+    if (x + size <= x0 || y + size <= y0 || x >= x0 + image.width() || y >= y0 + image.height()) return;
+    if (n.level == 0) {
+        image.set(std::int32_t(x - x0), std::int32_t(y - y0), 0xFFFFFF);
+        return;
+    }
+    auto const half = size / 2;
+    render(image, n.nw, x,        y,        x0, y0);
+    render(image, n.ne, x + half, y,        x0, y0);
+    render(image, n.sw, x,        y + half, x0, y0);
+    render(image, n.se, x + half, y + half, x0, y0);
+}
+
+auto hashlife::str() const -> std::string {
+    std::string str{"nrv::hashlife { "};
+    str += "generation: " + std::to_string(m_generation) + ", ";
+    str += "population: " + std::to_string(population()) + ", ";
+    str += "level: " + std::to_string(level()) + ", ";
+    str += "nodes: " + std::to_string(m_nodes.size()) + " }";
+    return str;
+}
+}  // namespace nrv
@@ -0,0 +1,102 @@
+/**
+ * @file   hashlife.hpp
+ * @author Pratchaya Khansomboon (me@mononerv.dev)
+ * @brief  HashLife, memoized quadtree Game of Life for very long runs.
+ * @date   2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ */
+#ifndef NRV_HASHLIFE_HPP
+#define NRV_HASHLIFE_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "mono/common.hpp"
+#include "mono/image.hpp"
+
+namespace nrv {
+// The board is a quadtree where every node is a 2^level square. Nodes are
+// canonical, a hash table makes sure each distinct square exists only once,
+// so repeated structure in space and time is stored and computed once.
+//
+// Each node caches its successor, the centre half of the square advanced by
+// 2^step generations. Successors of big nodes are built from successors of
+// their children, which lets one step() jump 2^k generations in time
+// roughly proportional to the amount of distinct structure instead of area.
+//
+// The board is unbounded, cell coordinates are signed with y down and the
+// root grows as needed up to 2^62 cells across.
+class hashlife {
+  public:
+    static constexpr std::uint32_t max_level = 62;
+
+  public:
+    hashlife();
+    ~hashlife() = default;
+
+    auto get(std::int64_t const& x, std::int64_t const& y) const -> bool;
+    auto set(std::int64_t const& x, std::int64_t const& y, bool const& alive) -> void;
+    auto clear() -> void;
+
+    // Advance the board by 2^log2_generations generations.
+    auto step(std::uint32_t const& log2_generations) -> void;
+    auto generation() const -> std::uint64_t { return m_generation; }
+    auto population() const -> std::uint64_t { return m_nodes[m_root].population; }
+
+    // Drop every node not reachable from the board, cached successors of
+    // surviving nodes are kept when their result survives too.
+    auto collect() -> void;
+    // Node count that triggers a collection after a step.
+    auto set_gc_threshold(std::size_t const& nodes) -> void { m_gc_threshold = nodes; }
+    auto nodes() const -> std::size_t { return m_nodes.size(); }
+    auto level() const -> std::uint32_t { return m_nodes[m_root].level; }
+
+    // Draw cells [x0, x0 + width) x [y0, y0 + height) into the image.
+    auto render(mno::image& image, std::int64_t const& x0, std::int64_t const& y0) const -> void;
+
+    [[nodiscard]] auto str() const -> std::string;
+
+  private:
+    static constexpr std::uint32_t invalid_node = 0xFFFFFFFF;
+
+    struct node {
+        std::uint32_t nw, ne, sw, se;
+        std::uint32_t result;       // cached successor, invalid_node when unset
+        std::uint8_t  level;
+        std::uint8_t  result_step;  // log2 generations the result advanced
+        std::uint64_t population;
+    };
+
+    auto join(std::uint32_t const& nw, std::uint32_t const& ne,
+              std::uint32_t const& sw, std::uint32_t const& se) -> std::uint32_t;
+    auto empty(std::uint32_t const& level) -> std::uint32_t;
+    auto expand(std::uint32_t const& index) -> std::uint32_t;
+    auto is_padded(std::uint32_t const& index) const -> bool;
+    auto centre(std::uint32_t const& index) -> std::uint32_t;
+    auto centre_horizontal(std::uint32_t const& w, std::uint32_t const& e) -> std::uint32_t;
+    auto centre_vertical(std::uint32_t const& n, std::uint32_t const& s) -> std::uint32_t;
+    auto successor(std::uint32_t const& index, std::uint32_t const& step) -> std::uint32_t;
+    auto successor_base(std::uint32_t const& index) -> std::uint32_t;
+    auto set(std::uint32_t const& index, std::uint64_t const& x, std::uint64_t const& y,
+             bool const& alive) -> std::uint32_t;
+    auto fits(std::int64_t const& x, std::int64_t const& y) const -> bool;
+    auto render(mno::image& image, std::uint32_t const& index, std::int64_t const& x, std::int64_t const& y,
+                std::int64_t const& x0, std::int64_t const& y0) const -> void;
+
+    static auto hash(std::uint32_t const& nw, std::uint32_t const& ne,
+                     std::uint32_t const& sw, std::uint32_t const& se) -> std::uint64_t;
+    auto rehash(std::size_t const& size) -> void;
+
+  private:
+    std::vector<node>          m_nodes{};
+    std::vector<std::uint32_t> m_table{};  // open addressing over m_nodes, invalid_node is empty
+    std::vector<std::uint32_t> m_empty{};  // canonical empty node per level
+    std::uint32_t              m_root{0};
+    std::uint64_t              m_generation{0};
+    std::size_t                m_gc_threshold{std::size_t(1) << 22};
+};
+}  // namespace nrv
+
+#endif // NRV_HASHLIFE_HPP
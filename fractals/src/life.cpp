@@ -0,0 +1,269 @@
+/**
+ * @file   life.cpp
+ * @author Pratchaya Khansomboon (me@mononerv.dev)
+ * @brief  Bit-packed Conway's Game of Life on the CPU.
+ * @date   2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ */
+#include "life.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+
+#include "mono/random.hpp"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define NRV_X86 1
+#include <immintrin.h>
+#endif
+
+#if defined(NRV_X86) && (defined(__GNUC__) || defined(__clang__))
+#define NRV_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define NRV_TARGET_AVX2
+#endif
+
+namespace nrv {
+// Neighbour count of 64 cells at once. The eight neighbour bitboards are
+// reduced with full adders into ones, twos and the carries into fours, a
+// cell lives on with exactly 2 or 3 neighbours and is born with 3.
+static inline auto next_word(std::uint64_t const& uw, std::uint64_t const& u, std::uint64_t const& ue,
+                             std::uint64_t const& mw, std::uint64_t const& m, std::uint64_t const& me,
+                             std::uint64_t const& dw, std::uint64_t const& d, std::uint64_t const& de) -> std::uint64_t {
+    auto const s0 = uw ^ u ^ ue;
+    auto const c0 = (uw & u) | (ue & (uw ^ u));
+    auto const s1 = mw ^ me ^ dw;
+    auto const c1 = (mw & me) | (dw & (mw ^ me));
+    auto const s2 = d ^ de;
+    auto const c2 = d & de;
+
+    auto const ones = s0 ^ s1 ^ s2;
+    auto const c3   = (s0 & s1) | (s2 & (s0 ^ s1));
+    auto const t0   = c0 ^ c1 ^ c2;
+    auto const c4   = (c0 & c1) | (c2 & (c0 ^ c1));
+    auto const twos = t0 ^ c3;
+    auto const c5   = t0 & c3;
+    return twos & ~(c4 | c5) & (ones | m);
+}
+
+static auto step_scalar(std::uint64_t const* up, std::uint64_t const* mid, std::uint64_t const* down,
+                        std::uint64_t* out, std::int32_t count) -> void {
+    for (std::int32_t i = 0; i < count; i++) {
+        // West neighbours shift in from the previous word, east from the next
+        out[i] = next_word(up[i] << 1 | up[i - 1] >> 63, up[i], up[i] >> 1 | up[i + 1] << 63,
+                           mid[i] << 1 | mid[i - 1] >> 63, mid[i], mid[i] >> 1 | mid[i + 1] << 63,
+                           down[i] << 1 | down[i - 1] >> 63, down[i], down[i] >> 1 | down[i + 1] << 63);
+    }
+}
+
+#ifdef NRV_X86
+// Helpers are separate functions since lambdas don't inherit the target attribute.
+NRV_TARGET_AVX2
+static inline auto load_avx2(std::uint64_t const* p) -> __m256i {
+    return _mm256_loadu_si256(reinterpret_cast<__m256i const*>(p));
+}
+// Unaligned loads one word back and forward line up the neighbouring word of
+// every lane, so the cross-word carries cost two shifts and an or.
+NRV_TARGET_AVX2
+static inline auto west_avx2(std::uint64_t const* p) -> __m256i {
+    return _mm256_or_si256(_mm256_slli_epi64(load_avx2(p), 1), _mm256_srli_epi64(load_avx2(p - 1), 63));
+}
+NRV_TARGET_AVX2
+static inline auto east_avx2(std::uint64_t const* p) -> __m256i {
+    return _mm256_or_si256(_mm256_srli_epi64(load_avx2(p), 1), _mm256_slli_epi64(load_avx2(p + 1), 63));
+}
+NRV_TARGET_AVX2
+static inline auto full_add_avx2(__m256i const& a, __m256i const& b, __m256i const& c, __m256i& carry) -> __m256i {
+    auto const ab = _mm256_xor_si256(a, b);
+    carry = _mm256_or_si256(_mm256_and_si256(a, b), _mm256_and_si256(c, ab));
+    return _mm256_xor_si256(ab, c);
+}
+
+NRV_TARGET_AVX2
+static auto step_avx2(std::uint64_t const* up, std::uint64_t const* mid, std::uint64_t const* down,
+                      std::uint64_t* out, std::int32_t count) -> void {
+    std::int32_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        auto const m = load_avx2(mid + i);
+        __m256i c0, c1, c3, c4;
+        auto const s0 = full_add_avx2(west_avx2(up + i), load_avx2(up + i), east_avx2(up + i), c0);
+        auto const s1 = full_add_avx2(west_avx2(mid + i), east_avx2(mid + i), west_avx2(down + i), c1);
+        auto const d  = load_avx2(down + i);
+        auto const de = east_avx2(down + i);
+        auto const s2 = _mm256_xor_si256(d, de);
+        auto const c2 = _mm256_and_si256(d, de);
+
+        auto const ones = full_add_avx2(s0, s1, s2, c3);
+        auto const t0   = full_add_avx2(c0, c1, c2, c4);
+        auto const twos = _mm256_xor_si256(t0, c3);
+        auto const c5   = _mm256_and_si256(t0, c3);
+        auto const next = _mm256_andnot_si256(_mm256_or_si256(c4, c5),
+                                              _mm256_and_si256(twos, _mm256_or_si256(ones, m)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), next);
+    }
+    step_scalar(up + i, mid + i, down + i, out + i, count - i);
+}
+#endif
+
+life::life(std::int32_t const& width, std::int32_t const& height, mno::simd_level const& level)
+    : m_width(width), m_height(height), m_level(level) {
+    if (width <= 0 || height <= 0) throw std::invalid_argument("life: board size must be positive");
+    m_words  = (width + 63) / 64;
+    m_stride = m_words + 2;
+    m_tail   = width % 64 == 0 ? ~std::uint64_t(0) : (std::uint64_t(1) << (width % 64)) - 1;
+    m_cells.assign(std::size_t(m_stride) * std::size_t(height + 2), 0);
+    m_next.assign(m_cells.size(), 0);
+    m_tiles_x = (m_words + tile_words - 1) / tile_words;
+    m_tiles_y = (height + tile_rows - 1) / tile_rows;
+    m_changed.assign(std::size_t(m_tiles_x) * std::size_t(m_tiles_y), 1);
+}
+
+auto life::get(std::int32_t const& x, std::int32_t const& y) const -> bool {
+    if (x < 0 || y < 0 || x >= m_width || y >= m_height) return false;
+    return (row(y)[x / 64] >> (x % 64)) & 1;
+}
+
+auto life::set(std::int32_t const& x, std::int32_t const& y, bool const& alive) -> void {
+    if (x < 0 || y < 0 || x >= m_width || y >= m_height) return;
+    auto& word = row(y)[x / 64];
+    auto const bit = std::uint64_t(1) << (x % 64);
+    word = alive ? word | bit : word & ~bit;
+    m_changed[std::size_t((y / tile_rows) * m_tiles_x + x / 64 / tile_words)] = 1;
+}
+
+auto life::clear() -> void {
+    std::fill(std::begin(m_cells), std::end(m_cells), 0);
+    m_generation = 0;
+    mark_changed();
+}
+
+auto life::randomize(std::uint64_t const& seed, mno::f32 const& density) -> void {
+    clear();
+    fill_random(seed, density, 0, m_height);
+}
+
+auto life::randomize(std::uint64_t const& seed, mno::f32 const& density, mno::tile_scheduler& scheduler) -> void {
+    clear();
+    scheduler.run(1, m_height, [&](mno::tile const& t) {
+        fill_random(seed, density, t.y0, t.y1);
+    });
+}
+
+auto life::fill_random(std::uint64_t const& seed, mno::f32 const& density,
+                       std::int32_t const& y0, std::int32_t const& y1) -> void {
+    // Word w of row y is word y * words + w of the random board
+    for (auto y = y0; y < y1; y++) {
+        auto words = row(y);
+        mno::random_bits(seed, std::uint64_t(y) * std::uint64_t(m_words), words, std::size_t(m_words), density);
+        words[m_words - 1] &= m_tail;
+    }
+}
+
+auto life::population() const -> std::uint64_t {
+    std::uint64_t count = 0;
+    for (std::int32_t y = 0; y < m_height; y++) {
+        auto const words = row(y);
+        for (std::int32_t w = 0; w < m_words; w++) count += std::uint64_t(std::popcount(words[w]));
+    }
+    return count;
+}
+
+auto life::step() -> void {
+    auto const fn = kernel(m_level);
+    collect_active();
+    for (auto const& index : m_active) step_tile(fn, index);
+    finish_step();
+}
+
+auto life::step(mno::tile_scheduler& scheduler) -> void {
+    auto const fn = kernel(m_level);
+    collect_active();
+    // The scheduler tiles the active list, every tile is a run of board tiles
+    if (!m_active.empty()) {
+        scheduler.run(std::int32_t(m_active.size()), 1, [&](mno::tile const& t) {
+            for (auto i = t.x0; i < t.x1; i++) step_tile(fn, m_active[std::size_t(i)]);
+        });
+    }
+    finish_step();
+}
+
+auto life::collect_active() -> void {
+    m_active.clear();
+    for (std::int32_t ty = 0; ty < m_tiles_y; ty++) {
+        for (std::int32_t tx = 0; tx < m_tiles_x; tx++) {
+            auto is_active = false;
+            for (auto y = std::max(ty - 1, 0); y <= std::min(ty + 1, m_tiles_y - 1) && !is_active; y++)
+                for (auto x = std::max(tx - 1, 0); x <= std::min(tx + 1, m_tiles_x - 1) && !is_active; x++)
+                    is_active = m_changed[std::size_t(y * m_tiles_x + x)] != 0;
+            if (is_active) m_active.push_back(std::uint32_t(ty * m_tiles_x + tx));
+        }
+    }
+    std::fill(std::begin(m_changed), std::end(m_changed), 0);
+}
+
+auto life::step_tile(life_kernel const& kernel, std::uint32_t const& index) -> void {
+    auto const tx = std::int32_t(index) % m_tiles_x;
+    auto const ty = std::int32_t(index) / m_tiles_x;
+    auto const x0 = tx * tile_words;
+    auto const x1 = std::min(x0 + tile_words, m_words);
+    auto const y0 = ty * tile_rows;
+    auto const y1 = std::min(y0 + tile_rows, m_height);
+
+    std::uint64_t diff = 0;
+    for (auto y = y0; y < y1; y++) {
+        auto const* mid = row(y) + x0;
+        auto* out = m_next.data() + offset(y) + x0;
+        kernel(mid - m_stride, mid, mid + m_stride, out, x1 - x0);
+        // Cells past the right edge must stay dead
+        if (x1 == m_words) out[x1 - x0 - 1] &= m_tail;
+        for (auto w = 0; w < x1 - x0; w++) diff |= out[w] ^ mid[w];
+    }
+    m_changed[index] = diff != 0;
+}
+
+auto life::finish_step() -> void {
+    std::swap(m_cells, m_next);
+    m_generation++;
+}
+
+auto life::mark_changed() -> void {
+    std::fill(std::begin(m_changed), std::end(m_changed), 1);
+}
+
+auto life::render(mno::image& image) const -> void {
+    render(image, 0, 0, m_width, m_height);
+}
+
+auto life::render(mno::image& image, std::int32_t const& x0, std::int32_t const& y0,
+                  std::int32_t const& x1, std::int32_t const& y1) const -> void {
+    if (image.width() != m_width || image.height() != m_height)
+        throw std::invalid_argument("life: image size does not match the board");
+    for (auto y = y0; y < y1; y++) {
+        auto const words = row(y);
+        for (auto x = x0; x < x1; x++) {
+            auto const alive = (words[x / 64] >> (x % 64)) & 1;
+            image.set(x, y, alive ? 0xFFFFFF : 0x000000);
+        }
+    }
+}
+
+auto life::kernel(mno::simd_level const& level) -> life_kernel {
+#ifdef NRV_X86
+    if (level >= mno::simd_level::avx2) return step_avx2;
+#else
+    (void)level;
+#endif
+    return step_scalar;
+}
+
+auto life::str() const -> std::string {
+    std::string str{"nrv::life { "};
+    str += "size: " + std::to_string(m_width) + "x" + std::to_string(m_height) + ", ";
+    str += "generation: " + std::to_string(m_generation) + ", ";
+    str += "active: " + std::to_string(m_active.size()) + "/" + std::to_string(m_changed.size()) + ", ";
+    str += "simd: " + mno::to_string(m_level) + " }";
+    return str;
+}
+}  // namespace nrv
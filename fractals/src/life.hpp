@@ -0,0 +1,130 @@
+/**
+ * @file   life.hpp
+ * @author Pratchaya Khansomboon (me@mononerv.dev)
+ * @brief  Bit-packed Conway's Game of Life on the CPU.
+ * @date   2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ */
+#ifndef NRV_LIFE_HPP
+#define NRV_LIFE_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "mono/common.hpp"
+#include "mono/cpu.hpp"
+#include "mono/image.hpp"
+#include "mono/tile_scheduler.hpp"
+
+namespace nrv {
+// Advances count words of one row. up, mid and down point at the first word
+// of the rows above, at and below, the words at [-1] and [count] must be
+// readable since neighbours are shifted in from them.
+using life_kernel = auto (*)(std::uint64_t const* up, std::uint64_t const* mid, std::uint64_t const* down,
+                             std::uint64_t* out, std::int32_t count) -> void;
+
+// 64 cells per word, bit i of word w is cell x = 64 w + i. Every row has a
+// zero guard word on each side and the board has a zero guard row above and
+// below, so cells outside the board are always dead and the kernels never
+// branch on the edge.
+//
+// A generation adds up the eight neighbour bitboards with bit-sliced full
+// adders, which gives the neighbour count of 64 cells in a few dozen logic
+// operations per word.
+//
+// The board is split into tiles of tile_words x tile_rows words and only
+// tiles that changed last generation, or border a tile that did, are stepped.
+// A skipped tile is stable so the back buffer already holds its next state,
+// which makes the work scale with activity instead of board area.
+class life {
+  public:
+    static constexpr std::int32_t tile_words = 8;
+    static constexpr std::int32_t tile_rows  = 64;
+
+  public:
+    life(std::int32_t const& width, std::int32_t const& height,
+         mno::simd_level const& level = mno::cpu_simd_level());
+    ~life() = default;
+
+    auto width() const -> std::int32_t { return m_width; }
+    auto height() const -> std::int32_t { return m_height; }
+    auto generation() const -> std::uint64_t { return m_generation; }
+    auto set_simd_level(mno::simd_level const& level) -> void { m_level = level; }
+    auto simd_level() const -> mno::simd_level { return m_level; }
+
+    auto get(std::int32_t const& x, std::int32_t const& y) const -> bool;
+    auto set(std::int32_t const& x, std::int32_t const& y, bool const& alive) -> void;
+    auto clear() -> void;
+    // Fill the board with cells alive with probability density. The board
+    // depends only on the seed and density, not on the thread count.
+    auto randomize(std::uint64_t const& seed, mno::f32 const& density = 0.5f) -> void;
+    auto randomize(std::uint64_t const& seed, mno::f32 const& density, mno::tile_scheduler& scheduler) -> void;
+    auto population() const -> std::uint64_t;
+
+    auto step() -> void;
+    // Step with the active tiles spread over the scheduler's threads.
+    auto step(mno::tile_scheduler& scheduler) -> void;
+    // Tiles stepped in the last generation.
+    auto active_tiles() const -> std::size_t { return m_active.size(); }
+
+    // Calls fn(x0, y0, x1, y1) with the cell rectangle of every tile that
+    // changed in the last generation.
+    template <typename Fn>
+    auto for_each_changed(Fn&& fn) const -> void {
+        for (std::int32_t ty = 0; ty < m_tiles_y; ty++) {
+            for (std::int32_t tx = 0; tx < m_tiles_x; tx++) {
+                if (!m_changed[std::size_t(ty * m_tiles_x + tx)]) continue;
+                auto const x0 = tx * tile_words * 64;
+                auto const y0 = ty * tile_rows;
+                fn(x0, y0, std::min(x0 + tile_words * 64, m_width), std::min(y0 + tile_rows, m_height));
+            }
+        }
+    }
+
+    // Alive cells white and dead cells black, image must be the board size.
+    auto render(mno::image& image) const -> void;
+    auto render(mno::image& image, std::int32_t const& x0, std::int32_t const& y0,
+                std::int32_t const& x1, std::int32_t const& y1) const -> void;
+
+    [[nodiscard]] auto str() const -> std::string;
+
+  public:
+    static auto kernel(mno::simd_level const& level) -> life_kernel;
+
+  private:
+    auto row(std::int32_t const& y) -> std::uint64_t* { return m_cells.data() + offset(y); }
+    auto row(std::int32_t const& y) const -> std::uint64_t const* { return m_cells.data() + offset(y); }
+    // Offset of the first board word of row y, y = -1 and y = height are guard rows.
+    auto offset(std::int32_t const& y) const -> std::size_t {
+        return std::size_t(y + 1) * std::size_t(m_stride) + 1;
+    }
+    auto fill_random(std::uint64_t const& seed, mno::f32 const& density,
+                     std::int32_t const& y0, std::int32_t const& y1) -> void;
+    auto collect_active() -> void;
+    // Step one tile and record whether any of its cells changed.
+    auto step_tile(life_kernel const& kernel, std::uint32_t const& index) -> void;
+    auto finish_step() -> void;
+    auto mark_changed() -> void;
+
+  private:
+    std::int32_t               m_width;
+    std::int32_t               m_height;
+    std::int32_t               m_words;   // board words per row
+    std::int32_t               m_stride;  // words per row including guards
+    std::uint64_t              m_tail;    // valid bits of the last word in a row
+    mno::simd_level            m_level;
+    std::uint64_t              m_generation{0};
+    std::vector<std::uint64_t> m_cells{};
+    std::vector<std::uint64_t> m_next{};
+
+    std::int32_t               m_tiles_x;
+    std::int32_t               m_tiles_y;
+    std::vector<std::uint8_t>  m_changed{};  // per tile, changed in the last generation
+    std::vector<std::uint32_t> m_active{};   // tiles to step this generation
+};
+}  // namespace nrv
+
+#endif // NRV_LIFE_HPP
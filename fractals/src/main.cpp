@@ -6,17 +6,30 @@
  *
  * @copyright Copyright (c) 2022
  */
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <cstdint>
 #include <string>
 #include <stdexcept>
 #include <iostream>
+#include <memory>
 #include <fstream>
 #include <random>
+#include <vector>
 
 #include "spdlog/spdlog.h"
 #include "mono/mono.hpp"
 #include "glad/glad.h"
 
+#include "frame_params.hpp"
+#include "dynamic_resolution.hpp"
+#include "hashlife.hpp"
+#include "life.hpp"
+#include "mandelbrot.hpp"
+#include "perturbation.hpp"
+#include "progressive.hpp"
+
 #include "ft2build.h"
 #include FT_FREETYPE_H
 
@@ -27,14 +40,70 @@ struct vertex {
     glm::vec2 uv;
 };
 
-auto read_text(std::string const& filename) -> std::string {
-    std::ifstream input{filename, std::ios::in};
-    if (!input.is_open() || input.fail())
-        throw std::runtime_error("ERROR: Loading textfile!");
-    return {
-        std::istreambuf_iterator<char>(input),
-        std::istreambuf_iterator<char>()
-    };
+// Binary PPM, rows are flipped since GL images start at the bottom.
+auto write_ppm(std::string const& filename, mno::image const& image) -> void {
+    std::ofstream output{filename, std::ios::out | std::ios::binary};
+    if (!output.is_open() || output.fail())
+        throw std::runtime_error("ERROR: Writing image " + filename);
+    output << "P6\n" << image.width() << " " << image.height() << "\n255\n";
+    std::vector<char> row(std::size_t(image.width()) * 3);
+    for (auto y = image.height() - 1; y >= 0; y--) {
+        for (auto x = 0; x < image.width(); x++) {
+            auto const color = image.get(x, y);
+            row[std::size_t(x) * 3 + 0] = char((color >> 16) & 0xFF);
+            row[std::size_t(x) * 3 + 1] = char((color >>  8) & 0xFF);
+            row[std::size_t(x) * 3 + 2] = char((color >>  0) & 0xFF);
+        }
+        output.write(row.data(), std::streamsize(row.size()));
+    }
+}
+
+// Command line, --headless renders frames offscreen and exits:
+//   fractals --headless --size 3840x2160 --time 1.5 --frames 120 --output frame.ppm
+// With more than one frame the index is appended, frame_0000.ppm, frame_0001.ppm...
+struct options {
+    bool         headless = false;
+    std::int32_t width    = 1920;
+    std::int32_t height   = 1080;
+    mno::f32     time     = 0.0f;
+    std::int32_t frames   = 1;
+    std::string  output   = "frame.ppm";
+};
+
+auto frame_filename(options const& opts, std::uint64_t const& frame) -> std::string {
+    if (opts.frames <= 1) return opts.output;
+    auto const dot  = opts.output.rfind('.');
+    auto const stem = opts.output.substr(0, dot);
+    auto const ext  = dot == std::string::npos ? std::string{} : opts.output.substr(dot);
+    auto index = std::to_string(frame);
+    index.insert(0, index.size() < 4 ? 4 - index.size() : 0, '0');
+    return stem + "_" + index + ext;
+}
+
+auto parse_options(std::int32_t argc, char const* argv[]) -> options {
+    options opts{};
+    for (std::int32_t i = 1; i < argc; i++) {
+        std::string const arg{argv[i]};
+        auto const has_value = i + 1 < argc;
+        if (arg == "--headless") {
+            opts.headless = true;
+        } else if (arg == "--size" && has_value) {
+            std::string const size{argv[++i]};
+            auto const x = size.find('x');
+            if (x == std::string::npos) throw std::runtime_error("ERROR: --size expects WIDTHxHEIGHT");
+            opts.width  = std::stoi(size.substr(0, x));
+            opts.height = std::stoi(size.substr(x + 1));
+        } else if (arg == "--time" && has_value) {
+            opts.time = std::stof(argv[++i]);
+        } else if (arg == "--frames" && has_value) {
+            opts.frames = std::max(std::stoi(argv[++i]), 1);
+        } else if (arg == "--output" && has_value) {
+            opts.output = argv[++i];
+        } else {
+            throw std::runtime_error("ERROR: Unknown argument " + arg);
+        }
+    }
+    return opts;
 }
 
 template <typename T, std::size_t N>
@@ -61,11 +130,13 @@ struct keystate {
 };
 }
 
-auto main([[maybe_unused]]std::int32_t argc, [[maybe_unused]]char const* argv[]) -> std::int32_t {
-    mno::window window{};
+auto main(std::int32_t argc, char const* argv[]) -> std::int32_t {
+    auto const options = nrv::parse_options(argc, argv);
+    mno::window window{{.headless = options.headless}};
     //window.set_position(window.xpos(), -800);
 
     auto graphics = window.graphics_context();
+    mno::shader::set_cache_directory(".cache/shaders");
 
     FT_Library font_library;
     if (FT_Init_FreeType(&font_library)) {
@@ -100,13 +171,24 @@ auto main([[maybe_unused]]std::int32_t argc, [[maybe_unused]]char const* argv[])
         0, 2, 3
     };
 
+    // Time, resolution and mouse go to every program through one uniform
+    // buffer written once per frame instead of glUniform calls per pass.
+    nrv::frame_params frame_params{};
+    mno::uniform_buffer frame_buffer{sizeof(nrv::frame_params), nrv::frame_params_binding};
+
     auto load_shader = [] {
-        return mno::shader::make(
-            nrv::read_text("./shaders/410.shader.gl.vert"),
-            nrv::read_text("./shaders/410.koch3d.gl.frag")
-        );
+        auto program = mno::shader::load("./shaders/410.shader.gl.vert", "./shaders/410.koch3d.gl.frag");
+        program->bind_block("frame_params", nrv::frame_params_binding);
+        return program;
     };
     auto shader = load_shader();
+    auto texture_shader = mno::shader::load("./shaders/410.shader.gl.vert", "./shaders/410.texture.gl.frag");
+    auto life_shader = mno::shader::load("./shaders/410.shader.gl.vert", "./shaders/410.conway_post.gl.frag");
+    life_shader->bind_block("frame_params", nrv::frame_params_binding);
+    auto conway_shader = mno::shader::load("./shaders/410.shader.gl.vert", "./shaders/410.conway.gl.frag");
+    conway_shader->bind_block("frame_params", nrv::frame_params_binding);
+    auto noise_shader = mno::shader::load("./shaders/410.shader.gl.vert", "./shaders/410.noise.gl.frag");
+    auto colormap_shader = mno::shader::load("./shaders/410.shader.gl.vert", "./shaders/410.colormap.gl.frag");
 
     mno::array_buffer array_buffer{};
     array_buffer.add_vertex_buffer(mno::vertex_buffer::make(vertices, sizeof(vertices), {
@@ -116,55 +198,268 @@ auto main([[maybe_unused]]std::int32_t argc, [[maybe_unused]]char const* argv[])
     }));
     array_buffer.set_index_buffer(mno::index_buffer::make(indices, sizeof(indices), static_cast<std::int32_t>(nrv::length_of(indices))));
 
+    if (options.headless) {
+        mno::framebuffer target{options.width, options.height};
+        mno::readback readback{options.width, options.height};
+        // Reused for every frame, rows aligned for direct SIMD access
+        mno::image frame{options.width, options.height, 4, mno::image::alignment};
+        auto write_frame = [&] {
+            nrv::write_ppm(nrv::frame_filename(options, readback.frame()), frame);
+        };
+
+        // Frames are written out while later ones render, the readback only
+        // waits on the GPU when every buffer in the ring is still in flight.
+        for (std::int32_t i = 0; i < options.frames; i++) {
+            target.bind();
+            glViewport(0, 0, options.width, options.height);
+            glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+            glClear(GL_COLOR_BUFFER_BIT);
+
+            frame_params.resolution = {options.width, options.height};
+            frame_params.time       = options.time + mno::f32(i) / 60.0f;
+            frame_params.frame      = std::uint32_t(i);
+            frame_buffer.update(frame_params);
+
+            shader->bind();
+            graphics->draw_triangles(array_buffer);
+            target.unbind();
+
+            if (!readback.capture(target)) {
+                if (readback.fetch(frame, true)) write_frame();
+                readback.capture(target);
+            }
+            while (readback.fetch(frame)) write_frame();
+        }
+        while (readback.pending() > 0)
+            if (readback.fetch(frame, true)) write_frame();
+        if (readback.dropped() > 0) spdlog::warn("Dropped {} frames that failed to read back", readback.dropped());
+        spdlog::info("Wrote {} {}x{} frames to {}", options.frames - std::int32_t(readback.dropped()), options.width,
+                     options.height, options.output);
+        return 0;
+    }
+
     auto width  = window.buffer_width();
     auto height = window.buffer_height();
     //auto buffer = mno::make_local<mno::framebuffer>(width, height);
 
+    mno::tile_scheduler scheduler{};
+    spdlog::info(scheduler.str());
+
     std::random_device rdev;
-    std::mt19937 rng{rdev()};  // pass rdev into as seed
-    std::uniform_int_distribution<std::mt19937::result_type> dist(0, 1);
-
-    mno::image noise_image{width, height};
-    auto generate_noise = [&] {
-        for (auto i = 0; i < noise_image.height(); i++) {
-            for (auto j = 0; j < noise_image.width(); j++) {
-                auto data = mno::u8(dist(rng) * 255);
-                noise_image.set(j, i, data, data, data);
-            }
-        }
+    auto const noise_seed = rdev();
+
+    // CPU Mandelbrot view, toggled with M
+    nrv::mandelbrot mandelbrot{};
+    // Escape counts stay as floats, the colour map is applied by colormap_shader
+    mno::image mandelbrot_image{width, height, mno::pixel_format::r32f};
+    mno::streaming_texture mandelbrot_texture{width, height, mno::streaming_texture::default_depth,
+                                              mno::texture_format::r32f};
+    // Refined over several frames, each spends about this long on passes
+    nrv::progressive mandelbrot_progress{};
+    auto const progressive_budget_ms = 12.0;
+    auto is_mandelbrot    = false;
+    auto mandelbrot_dirty = true;
+    // Arrow keys pan and the wheel zooms, counts that land on the new pixel
+    // grid are reused
+    auto mandelbrot_target = mandelbrot.view();
+    // Finished frames are kept as tiles of escape counts, revisited views
+    // and restarts load them instead of rendering. On a partial hit the
+    // passes skip the loaded tiles.
+    nrv::tile_cache mandelbrot_cache{".cache/tiles"};
+    auto mandelbrot_stored = false;
+    auto load_mandelbrot = [&] {
+        std::atomic<bool> is_complete{true};
+        scheduler.run(mandelbrot_image, [&](mno::tile const& tile) {
+            if (mandelbrot.load(mandelbrot_image, mandelbrot_cache, tile.x0, tile.y0, tile.x1, tile.y1))
+                mandelbrot_texture.mark_dirty(tile.x0, tile.y0, tile.x1, tile.y1);
+            else
+                is_complete = false;
+        });
+        mandelbrot_stored = is_complete;
+        return bool(is_complete);
     };
-    generate_noise();
-    auto noise_texture = mno::make_ref<mno::texture>(noise_image);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-    glGenerateMipmap(GL_TEXTURE_2D);
+    spdlog::info(mandelbrot.str());
+    // Past mandelbrot::is_deep() the view is handed to perturbation, which
+    // keeps the centre as a decimal string, Z forces it at any zoom and S
+    // toggles the series approximation, str() logs the iterations it skipped
+    nrv::perturbation deep_mandelbrot{};
+    auto deep_target    = nrv::deep_zoom_view{};
+    auto is_deep        = false;
+    auto is_deep_forced = false;
+    auto deep_dirty     = true;
+
+    // CPU Game of Life, toggled with L, stepped once per frame
+    std::unique_ptr<nrv::life> life{};
+    mno::image life_image{width, height};
+    mno::streaming_texture life_texture{width, height};
+    auto is_life = false;
+
+    // GPU Game of Life, toggled with C, generations ping-pong between two R8 targets
+    mno::double_buffered_target conway_target{width, height};
+    auto is_conway          = false;
+    auto conway_seeded      = false;
+    auto conway_generations = std::int32_t(1);
+    auto seed_conway = [&] {
+        conway_target.resize(width, height);
+        conway_target.back().bind();
+        glViewport(0, 0, conway_target.width(), conway_target.height());
+        // Same cells mno::random_fill would produce for an image of the target size
+        noise_shader->bind();
+        noise_shader->num("u_seed_lo", mno::u32(noise_seed));
+        noise_shader->num("u_seed_hi", mno::u32(0));
+        noise_shader->num("u_threshold", mno::random_threshold(0.5f));
+        noise_shader->num("u_width", mno::i32(conway_target.width()));
+        graphics->draw_triangles(array_buffer);
+        conway_target.swap();
+        conway_target.front().unbind();
+        conway_seeded = true;
+    };
+
+    // HashLife view, toggled with H, [ and ] halve and double the generations per frame
+    nrv::hashlife hashlife{};
+    auto is_hashlife   = false;
+    auto hashlife_step = std::uint32_t(0);
+    auto reset_hashlife = [&] {
+        // Acorn, a methuselah that runs for 5206 generations
+        hashlife.clear();
+        std::int32_t const acorn[][2]{{1, 0}, {3, 1}, {0, 2}, {1, 2}, {4, 2}, {5, 2}, {6, 2}};
+        for (auto const& cell : acorn) hashlife.set(cell[0] - 3, cell[1] - 1, true);
+    };
+
+    // Life views share a camera, the arrow keys pan and the wheel zooms.
+    // conway_post samples the board through frame_params location and zoom,
+    // in texture coordinates with zoom the visible fraction of the board.
+    auto life_location = glm::vec2{0.0f};
+    auto life_zoom     = 1.0f;
+    auto is_life_view  = [&] { return is_conway || is_hashlife || is_life; };
+
+    // Koch3D renders into a scaled target sized from its GPU time and is
+    // upscaled to the screen, D switches back to full resolution rendering
+    nrv::dynamic_resolution koch_resolution{};
+    mno::framebuffer koch_target{width, height};
+    koch_target.texture()->set_filter(mno::texture_filter::linear);
+    auto is_dynamic  = true;
+    auto koch_camera = std::array<mno::f64, 4>{};
 
     auto current_time = window.time();
     auto last_time    = current_time;
     [[maybe_unused]]auto delta_time   = current_time - last_time;
     auto is_running   = true;
 
+    mno::profiler profiler{};
+
     auto key_down = [&](mno::event const& event) {
-        auto e = static_cast<mno::key_down_event const&>(event);
+        auto const& e = static_cast<mno::key_down_event const&>(event);
         if (e.key() == mno::key::Q)
             is_running = false;
+        if (is_life_view()) {
+            auto const step = 0.125f * life_zoom;
+            if (e.key() == mno::key::LEFT)  life_location.x -= step;
+            if (e.key() == mno::key::RIGHT) life_location.x += step;
+            if (e.key() == mno::key::UP)    life_location.y += step;
+            if (e.key() == mno::key::DOWN)  life_location.y -= step;
+        } else if (is_mandelbrot) {
+            // Whole pixels so the panned view reuses every pixel that stays visible
+            auto const pixel = (is_deep ? deep_target.scale : mandelbrot_target.scale) / width;
+            auto const step  = mno::f64(std::max(width / 8, 1)) * pixel;
+            auto dx = 0.0, dy = 0.0;
+            if (e.key() == mno::key::LEFT)  dx -= step;
+            if (e.key() == mno::key::RIGHT) dx += step;
+            if (e.key() == mno::key::UP)    dy -= step;
+            if (e.key() == mno::key::DOWN)  dy += step;
+            if (dx == 0.0 && dy == 0.0) return;
+            if (is_deep) {
+                deep_target = nrv::pan(deep_target, dx, dy);
+                deep_dirty  = true;
+            } else {
+                mandelbrot_target.center_x += dx;
+                mandelbrot_target.center_y += dy;
+            }
+        }
+    };
+    auto mouse_wheel = [&](mno::event const& event) {
+        auto const& e = static_cast<mno::mouse_wheel_event const&>(event);
+        if (e.dy() == 0.0) return;
+        auto const factor = e.dy() > 0.0 ? 0.5 : 2.0;
+        if (is_life_view()) {
+            life_zoom = std::clamp(life_zoom * mno::f32(factor), 1.0f / 64.0f, 4.0f);
+            return;
+        }
+        if (!is_mandelbrot) return;
+        if (is_deep) {
+            deep_target.scale *= factor;
+            deep_dirty = true;
+        } else {
+            mandelbrot_target.scale *= factor;
+        }
     };
     auto key_up = [&](mno::event const& event) {
-        auto e = static_cast<mno::key_down_event const&>(event);
+        auto const& e = static_cast<mno::key_up_event const&>(event);
         if (e.key() == mno::key::R) {
             try {
                 shader = load_shader();
+                koch_resolution.invalidate();
                 spdlog::info("Reload shader");
-            } catch(std::runtime_error const& e) {
-                spdlog::error(e.what());
+            } catch(std::runtime_error const& error) {
+                spdlog::error(error.what());
             }
         }
+        if (e.key() == mno::key::M) {
+            is_mandelbrot    = !is_mandelbrot;
+            mandelbrot_dirty = true;
+            deep_dirty       = true;
+        }
+        if (e.key() == mno::key::Z && is_mandelbrot) {
+            is_deep_forced = !is_deep_forced;
+            spdlog::info("Perturbation {}", is_deep_forced ? "forced" : "past the f64 limit only");
+        }
+        if (e.key() == mno::key::S && is_mandelbrot) {
+            deep_mandelbrot.set_series_approximation(!deep_mandelbrot.is_series_approximation());
+            deep_dirty = true;
+            spdlog::info("Series approximation {}", deep_mandelbrot.is_series_approximation() ? "on" : "off");
+        }
+        if (e.key() == mno::key::L) {
+            is_life = !is_life;
+            life.reset();
+        }
+        if (e.key() == mno::key::C) {
+            is_conway     = !is_conway;
+            conway_seeded = false;
+        }
+        if (e.key() == mno::key::H) {
+            is_hashlife = !is_hashlife;
+            if (is_hashlife) reset_hashlife();
+            life.reset();  // the views share life_image
+        }
+        if (e.key() == mno::key::D) {
+            is_dynamic = !is_dynamic;
+            koch_resolution.invalidate();
+            spdlog::info("Dynamic resolution {}", is_dynamic ? "on" : "off");
+        }
+        if (e.key() == mno::key::P) {
+            if (!profiler.is_tracing()) {
+                profiler.start_trace();
+                spdlog::info("Profiler trace started");
+            } else {
+                profiler.stop_trace();
+                try {
+                    profiler.write_trace("trace.json");
+                    spdlog::info("Profiler trace written to trace.json, {}", profiler.str());
+                } catch(std::runtime_error const& error) {
+                    spdlog::error(error.what());
+                }
+            }
+        }
+        if (e.key() == mno::key::LEFT_BRACKET && hashlife_step > 0) hashlife_step--;
+        if (e.key() == mno::key::RIGHT_BRACKET && hashlife_step < 32) hashlife_step++;
     };
     window.add_event_listener(mno::event_type::key_down, key_down);
+    window.add_event_listener(mno::event_type::mouse_wheel, mouse_wheel);
     window.add_event_listener(mno::event_type::key_up, key_up);
 
     mno::f64 mouse_posx, mouse_posy;
     while (is_running) {
+        profiler.begin_frame();
         last_time    = current_time;
         current_time = window.time();
         delta_time   = current_time - last_time;
@@ -172,19 +467,165 @@ auto main([[maybe_unused]]std::int32_t argc, [[maybe_unused]]char const* argv[])
         window.buffer_size(width, height);
         window.mouse_pos(mouse_posx, mouse_posy);
 
+        frame_params.resolution = {width, height};
+        frame_params.mouse      = {mouse_posx, mouse_posy};
+        frame_params.time       = mno::f32(current_time);
+        frame_params.location   = life_location;
+        frame_params.zoom       = life_zoom;
+        frame_buffer.update(frame_params);
+        frame_params.frame++;
+
         // OUTPUT TO SCREEN PASS
         glViewport(0, 0, width, height);
         glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
         glClear(GL_COLOR_BUFFER_BIT);
 
-        shader->bind();
-        shader->num("u_time", mno::f32(window.time()));
-        shader->vec2("u_resolution", {width, height});
-        shader->vec2("u_mouse", {mouse_posx, mouse_posy});
-
-        graphics->draw_triangles(array_buffer);
+        if (is_conway) {
+            auto scope = profiler.pass("conway");
+            if (!conway_seeded || conway_target.width() != width || conway_target.height() != height)
+                seed_conway();
+            conway_target.run(conway_generations, 1, [&] {
+                conway_shader->bind();
+                conway_shader->num("u_texture1", 1);
+                graphics->draw_triangles(array_buffer);
+            });
+            glViewport(0, 0, width, height);
+            life_shader->bind();
+            conway_target.texture()->bind(0);
+            life_shader->num("u_texture", 0);
+        } else if (is_hashlife) {
+            auto scope = profiler.pass("hashlife");
+            hashlife.step(hashlife_step);
+            life_image.resize(width, height);
+            life_texture.resize(width, height);
+            hashlife.render(life_image, -width / 2, -height / 2);
+            life_texture.mark_dirty();
+            life_texture.flush(life_image);
+            life_shader->bind();
+            life_texture.bind(0);
+            life_shader->num("u_texture", 0);
+        } else if (is_life) {
+            auto scope = profiler.pass("life");
+            if (life == nullptr || life->width() != width || life->height() != height) {
+                life = std::make_unique<nrv::life>(width, height);
+                life->randomize(noise_seed, 0.5f, scheduler);
+                life_image.resize(width, height);
+                life_texture.resize(width, height);
+                spdlog::info(life->str());
+                life->render(life_image);
+                life_texture.mark_dirty();
+            } else {
+                // Only tiles that changed are redrawn and uploaded
+                life->step(scheduler);
+                life->for_each_changed([&](std::int32_t x0, std::int32_t y0, std::int32_t x1, std::int32_t y1) {
+                    life->render(life_image, x0, y0, x1, y1);
+                    life_texture.mark_dirty(x0, y0, x1, y1);
+                });
+            }
+            life_texture.flush(life_image);
+            life_shader->bind();
+            life_texture.bind(0);
+            life_shader->num("u_texture", 0);
+        } else if (is_mandelbrot) {
+            auto scope = profiler.pass("mandelbrot");
+            // Handed over once f64 runs out of precision and back once it suffices again
+            auto const wants_deep = is_deep_forced ||
+                nrv::mandelbrot::is_deep(is_deep ? nrv::mandelbrot_view_of(deep_target) : mandelbrot_target, width);
+            if (wants_deep != is_deep) {
+                is_deep = wants_deep;
+                if (is_deep) {
+                    auto const iterations = deep_target.max_iterations;
+                    deep_target = nrv::deep_zoom_view_of(mandelbrot_target);
+                    deep_target.max_iterations = std::max(iterations, mandelbrot_target.max_iterations);
+                    deep_dirty = true;
+                } else {
+                    auto const iterations = mandelbrot_target.max_iterations;
+                    mandelbrot_target = nrv::mandelbrot_view_of(deep_target);
+                    mandelbrot_target.max_iterations = iterations;
+                    mandelbrot_dirty = true;
+                }
+                spdlog::info("Mandelbrot view handed to {}", is_deep ? "perturbation" : "f64 kernels");
+            }
+            if (is_deep) {
+                // Rendered in one go, the reference orbit makes partial frames no cheaper
+                if (deep_dirty || mandelbrot_image.width() != width || mandelbrot_image.height() != height) {
+                    mandelbrot_image.resize(width, height, mno::pixel_format::r32f);
+                    mandelbrot_texture.resize(width, height);
+                    deep_mandelbrot.set_view(deep_target);
+                    deep_mandelbrot.render(mandelbrot_image, scheduler);
+                    mandelbrot_texture.mark_dirty();
+                    spdlog::info(deep_mandelbrot.str());
+                    deep_dirty = false;
+                }
+            } else if (mandelbrot_dirty || mandelbrot_image.width() != width || mandelbrot_image.height() != height) {
+                mandelbrot_image.resize(width, height, mno::pixel_format::r32f);
+                mandelbrot_texture.resize(width, height);
+                mandelbrot.set_view(mandelbrot_target);
+                mandelbrot.prepare(mandelbrot_image);
+                if (load_mandelbrot()) mandelbrot_progress.finish();
+                else mandelbrot_progress.restart();
+                mandelbrot_dirty = false;
+            } else if (mandelbrot_target != mandelbrot.view()) {
+                // Counts that stay exact in the new view are kept, even from an
+                // unfinished frame, and the passes only render the rest
+                mandelbrot.reproject(mandelbrot_target, mandelbrot_image);
+                if (load_mandelbrot()) mandelbrot_progress.finish();
+                else mandelbrot_progress.restart();
+            }
+            // Coarse passes first, a partial frame is shown after every budget
+            if (!is_deep && !mandelbrot_progress.is_done()) {
+                mandelbrot_progress.run(width, height, scheduler, progressive_budget_ms,
+                                        [&](nrv::interlace_pass const& pass, mno::tile const& tile) {
+                    mandelbrot.render(mandelbrot_image, pass, tile.x0, tile.y0, tile.x1, tile.y1);
+                    mandelbrot_texture.mark_dirty(tile.x0, tile.y0, tile.x1, tile.y1);
+                });
+            }
+            // Only tiles with rendered pixels are cached, the files are written
+            // off the frame by the cache's writer
+            if (!is_deep && mandelbrot_progress.is_done() && !mandelbrot_stored) {
+                scheduler.run(mandelbrot_image, [&](mno::tile const& tile) {
+                    mandelbrot.store(mandelbrot_image, mandelbrot_cache, tile.x0, tile.y0, tile.x1, tile.y1);
+                });
+                mandelbrot_stored = true;
+            }
+            mandelbrot_texture.flush(mandelbrot_image);
+            colormap_shader->bind();
+            mandelbrot_texture.bind(0);
+            colormap_shader->num("u_texture", 0);
+            auto const max_iterations = is_deep ? deep_mandelbrot.view().max_iterations : mandelbrot.view().max_iterations;
+            colormap_shader->num("u_max_iterations", mno::f32(max_iterations));
+        } else if (is_dynamic) {
+            auto const camera = std::array<mno::f64, 4>{mouse_posx, mouse_posy, mno::f64(width), mno::f64(height)};
+            koch_resolution.update(profiler.frame(), camera != koch_camera, profiler.latest());
+            koch_camera = camera;
+            if (koch_resolution.needs_render()) {
+                auto scope = profiler.pass("koch3d");
+                auto const [target_width, target_height] = koch_resolution.render_size(width, height);
+                if (koch_target.width() != target_width || koch_target.height() != target_height)
+                    koch_target.resize(target_width, target_height);
+                koch_target.bind();
+                glViewport(0, 0, target_width, target_height);
+                shader->bind();
+                shader->num("u_max_steps", koch_resolution.max_steps());
+                graphics->draw_triangles(array_buffer);
+                koch_target.unbind();
+                glViewport(0, 0, width, height);
+                koch_resolution.rendered();
+            }
+            texture_shader->bind();
+            koch_target.texture()->bind(0);
+            texture_shader->num("u_texture", 0);
+        } else {
+            shader->bind();
+            shader->num("u_max_steps", 0);
+        }
 
-        window.swap();
+        {
+            auto scope = profiler.pass("present");
+            graphics->draw_triangles(array_buffer);
+            window.swap();
+        }
+        profiler.end_frame();
         window.poll();
     }
 
@@ -0,0 +1,501 @@
+/**
+ * @file   mandelbrot.cpp
+ * @author Pratchaya Khansomboon (me@mononerv.dev)
+ * @brief  CPU Mandelbrot escape-time renderer with SIMD kernels.
+ * @date   2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ */
+#include "mandelbrot.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define NRV_X86 1
+#include <immintrin.h>
+#endif
+
+// AVX2 kernels are compiled for the target on demand so the rest of the
+// program keeps the baseline instruction set, dispatch happens at runtime.
+// FMA is left out on purpose, a fused multiply-add rounds once where the
+// other kernels round twice and the counts would depend on the machine.
+#if defined(NRV_X86) && (defined(__GNUC__) || defined(__clang__))
+#define NRV_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define NRV_TARGET_AVX2
+#endif
+
+namespace nrv {
+// Coordinate of the centre of pixel index i on the grid. Every render path
+// goes through here with an integer index, so a pixel lands on the same
+// coordinate no matter which pass, call or view computes it.
+static inline auto coordinate(mno::f64 const& pixel, std::int64_t const& i) -> mno::f64 {
+    return mno::f64(i) * pixel;
+}
+
+template <typename T>
+static auto escape_scalar(mno::f64 pixel, mno::f64 y, std::int64_t x0, std::int32_t dx, std::int32_t count,
+                          std::uint32_t max_iterations, std::uint32_t* out) -> void {
+    auto const ci = static_cast<T>(y);
+    for (std::int32_t i = 0; i < count; i++) {
+        auto const cr = static_cast<T>(coordinate(pixel, x0 + dx * i));
+        T zr{0}, zi{0}, zr2{0}, zi2{0};
+        std::uint32_t n = 0;
+        for (; n < max_iterations; n++) {
+            zi  = T(2) * zr * zi + ci;
+            zr  = zr2 - zi2 + cr;
+            zr2 = zr * zr;
+            zi2 = zi * zi;
+            if (!(zr2 + zi2 < T(4))) break;
+        }
+        out[i] = n;
+    }
+}
+
+#ifdef NRV_X86
+static auto escape_sse2_f32(mno::f64 pixel, mno::f64 y, std::int64_t x0, std::int32_t dx, std::int32_t count,
+                            std::uint32_t max_iterations, std::uint32_t* out) -> void {
+    auto const two  = _mm_set1_ps(2.0f);
+    auto const four = _mm_set1_ps(4.0f);
+    auto const ci   = _mm_set1_ps(static_cast<mno::f32>(y));
+    alignas(16) std::uint32_t lanes[4];
+    for (std::int32_t i = 0; i < count; i += 4) {
+        auto const cr = _mm_setr_ps(static_cast<mno::f32>(coordinate(pixel, x0 + dx * (i + 0))),
+                                    static_cast<mno::f32>(coordinate(pixel, x0 + dx * (i + 1))),
+                                    static_cast<mno::f32>(coordinate(pixel, x0 + dx * (i + 2))),
+                                    static_cast<mno::f32>(coordinate(pixel, x0 + dx * (i + 3))));
+        auto zr  = _mm_setzero_ps();
+        auto zi  = _mm_setzero_ps();
+        auto zr2 = _mm_setzero_ps();
+        auto zi2 = _mm_setzero_ps();
+        auto n   = _mm_setzero_si128();
+        auto active = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        for (std::uint32_t k = 0; k < max_iterations; k++) {
+            zi  = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(two, zr), zi), ci);
+            zr  = _mm_add_ps(_mm_sub_ps(zr2, zi2), cr);
+            zr2 = _mm_mul_ps(zr, zr);
+            zi2 = _mm_mul_ps(zi, zi);
+            active = _mm_and_ps(active, _mm_cmplt_ps(_mm_add_ps(zr2, zi2), four));
+            if (_mm_movemask_ps(active) == 0) break;
+            n = _mm_sub_epi32(n, _mm_castps_si128(active));  // active lanes are -1
+        }
+        _mm_store_si128(reinterpret_cast<__m128i*>(lanes), n);
+        std::copy_n(lanes, std::min(count - i, 4), out + i);
+    }
+}
+static auto escape_sse2_f64(mno::f64 pixel, mno::f64 y, std::int64_t x0, std::int32_t dx, std::int32_t count,
+                            std::uint32_t max_iterations, std::uint32_t* out) -> void {
+    auto const two  = _mm_set1_pd(2.0);
+    auto const four = _mm_set1_pd(4.0);
+    auto const ci   = _mm_set1_pd(y);
+    alignas(16) std::uint64_t lanes[2];
+    for (std::int32_t i = 0; i < count; i += 2) {
+        auto const cr = _mm_setr_pd(coordinate(pixel, x0 + dx * (i + 0)),
+                                    coordinate(pixel, x0 + dx * (i + 1)));
+        auto zr  = _mm_setzero_pd();
+        auto zi  = _mm_setzero_pd();
+        auto zr2 = _mm_setzero_pd();
+        auto zi2 = _mm_setzero_pd();
+        auto n   = _mm_setzero_si128();
+        auto active = _mm_castsi128_pd(_mm_set1_epi32(-1));
+        for (std::uint32_t k = 0; k < max_iterations; k++) {
+            zi  = _mm_add_pd(_mm_mul_pd(_mm_mul_pd(two, zr), zi), ci);
+            zr  = _mm_add_pd(_mm_sub_pd(zr2, zi2), cr);
+            zr2 = _mm_mul_pd(zr, zr);
+            zi2 = _mm_mul_pd(zi, zi);
+            active = _mm_and_pd(active, _mm_cmplt_pd(_mm_add_pd(zr2, zi2), four));
+            if (_mm_movemask_pd(active) == 0) break;
+            n = _mm_sub_epi64(n, _mm_castpd_si128(active));
+        }
+        _mm_store_si128(reinterpret_cast<__m128i*>(lanes), n);
+        for (std::int32_t j = 0; j < std::min(count - i, 2); j++)
+            out[i + j] = static_cast<std::uint32_t>(lanes[j]);
+    }
+}
+
+NRV_TARGET_AVX2
+static auto escape_avx2_f32(mno::f64 pixel, mno::f64 y, std::int64_t x0, std::int32_t dx, std::int32_t count,
+                            std::uint32_t max_iterations, std::uint32_t* out) -> void {
+    auto const four = _mm256_set1_ps(4.0f);
+    auto const ci   = _mm256_set1_ps(static_cast<mno::f32>(y));
+    alignas(32) std::uint32_t lanes[8];
+    for (std::int32_t i = 0; i < count; i += 8) {
+        alignas(32) mno::f32 xs[8];
+        for (std::int32_t j = 0; j < 8; j++) xs[j] = static_cast<mno::f32>(coordinate(pixel, x0 + dx * (i + j)));
+        auto const cr = _mm256_load_ps(xs);
+        auto zr  = _mm256_setzero_ps();
+        auto zi  = _mm256_setzero_ps();
+        auto zr2 = _mm256_setzero_ps();
+        auto zi2 = _mm256_setzero_ps();
+        auto n   = _mm256_setzero_si256();
+        auto active = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+        for (std::uint32_t k = 0; k < max_iterations; k++) {
+            zi  = _mm256_add_ps(_mm256_mul_ps(_mm256_add_ps(zr, zr), zi), ci);
+            zr  = _mm256_add_ps(_mm256_sub_ps(zr2, zi2), cr);
+            zr2 = _mm256_mul_ps(zr, zr);
+            zi2 = _mm256_mul_ps(zi, zi);
+            active = _mm256_and_ps(active, _mm256_cmp_ps(_mm256_add_ps(zr2, zi2), four, _CMP_LT_OQ));
+            if (_mm256_movemask_ps(active) == 0) break;
+            n = _mm256_sub_epi32(n, _mm256_castps_si256(active));
+        }
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), n);
+        std::copy_n(lanes, std::min(count - i, 8), out + i);
+    }
+}
+
+NRV_TARGET_AVX2
+static auto escape_avx2_f64(mno::f64 pixel, mno::f64 y, std::int64_t x0, std::int32_t dx, std::int32_t count,
+                            std::uint32_t max_iterations, std::uint32_t* out) -> void {
+    auto const four = _mm256_set1_pd(4.0);
+    auto const ci   = _mm256_set1_pd(y);
+    alignas(32) std::uint64_t lanes[4];
+    for (std::int32_t i = 0; i < count; i += 4) {
+        auto const cr = _mm256_setr_pd(coordinate(pixel, x0 + dx * (i + 0)),
+                                       coordinate(pixel, x0 + dx * (i + 1)),
+                                       coordinate(pixel, x0 + dx * (i + 2)),
+                                       coordinate(pixel, x0 + dx * (i + 3)));
+        auto zr  = _mm256_setzero_pd();
+        auto zi  = _mm256_setzero_pd();
+        auto zr2 = _mm256_setzero_pd();
+        auto zi2 = _mm256_setzero_pd();
+        auto n   = _mm256_setzero_si256();
+        auto active = _mm256_castsi256_pd(_mm256_set1_epi32(-1));
+        for (std::uint32_t k = 0; k < max_iterations; k++) {
+            zi  = _mm256_add_pd(_mm256_mul_pd(_mm256_add_pd(zr, zr), zi), ci);
+            zr  = _mm256_add_pd(_mm256_sub_pd(zr2, zi2), cr);
+            zr2 = _mm256_mul_pd(zr, zr);
+            zi2 = _mm256_mul_pd(zi, zi);
+            active = _mm256_and_pd(active, _mm256_cmp_pd(_mm256_add_pd(zr2, zi2), four, _CMP_LT_OQ));
+            if (_mm256_movemask_pd(active) == 0) break;
+            n = _mm256_sub_epi64(n, _mm256_castpd_si256(active));
+        }
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), n);
+        for (std::int32_t j = 0; j < std::min(count - i, 4); j++)
+            out[i + j] = static_cast<std::uint32_t>(lanes[j]);
+    }
+}
+#endif
+
+// Marks pixels without a computed count yet, no count reaches it
+static constexpr std::uint32_t missing_count = 0xFFFFFFFF;
+// Zooms further than this many factors of two in one step start over
+static constexpr std::int32_t max_reuse_octaves = 8;
+
+// Pixel (x, y) of a view is index (x0 + x, y0 + y) on the grid of all
+// multiples of pixel, so views that share the pixel size share the grid and
+// pixel sizes a power of two apart share every other grid point.
+struct pixel_grid {
+    mno::f64     pixel;
+    std::int64_t x0;
+    std::int64_t y0;
+};
+
+// Grid of the view, its centre rounded to the nearest pixel.
+static auto view_grid(mandelbrot_view const& view, std::int32_t const& width, std::int32_t const& height)
+    -> pixel_grid {
+    auto const pixel = view.scale / width;
+    return {pixel, std::llround(view.center_x / pixel + 0.5 - width * 0.5),
+            std::llround(view.center_y / pixel + 0.5 - height * 0.5)};
+}
+
+// Old pixel a new grid index lands on exactly, -1 if none. Sizes are
+// 2^octaves old pixels.
+static auto reused_index(std::int64_t const& index, std::int32_t const& octaves, std::int64_t const& old_x0,
+                         std::int32_t const& size) -> std::int32_t {
+    auto old = index;
+    if (octaves < 0) {
+        auto const step = std::int64_t(1) << -octaves;
+        if (index % step != 0) return -1;
+        old = index / step;
+    } else {
+        old = index * (std::int64_t(1) << octaves);
+    }
+    old -= old_x0;
+    return old >= 0 && old < size ? std::int32_t(old) : -1;
+}
+
+mandelbrot::mandelbrot(mandelbrot_view const& view, mno::simd_level const& level)
+    : m_view(view), m_level(level) {}
+
+auto mandelbrot::render(mno::image& image) -> void {
+    prepare(image);
+    render(image, 0, 0, image.width(), image.height());
+}
+
+auto mandelbrot::render(mno::image& image, mno::tile_scheduler& scheduler) -> void {
+    prepare(image);
+    scheduler.run(image, [&](mno::tile const& t) {
+        render(image, t.x0, t.y0, t.x1, t.y1);
+    });
+}
+
+auto mandelbrot::prepare(mno::image const& image) -> void {
+    auto const size = std::size_t(image.width()) * std::size_t(image.height());
+    m_iterations.assign(size, missing_count);
+    m_rendered.assign(size, 0);
+    m_width  = image.width();
+    m_height = image.height();
+}
+
+auto mandelbrot::render(mno::image& image, std::int32_t const& x0, std::int32_t const& y0,
+                        std::int32_t const& x1, std::int32_t const& y1) -> void {
+    auto const width  = image.width();
+    auto const escape = kernel(width);
+    auto const grid   = view_grid(m_view, width, image.height());
+    for (auto y = y0; y < y1; y++) {
+        auto row = m_iterations.data() + std::size_t(y) * std::size_t(width);
+        escape(grid.pixel, coordinate(grid.pixel, grid.y0 + y), grid.x0 + x0, 1, x1 - x0,
+               m_view.max_iterations, row + x0);
+        mark_rendered(image, x0, y, x1);
+    }
+    write(image, x0, y0, x1, y1);
+}
+
+auto mandelbrot::render(mno::image& image, interlace_pass const& pass, std::int32_t const& x0,
+                        std::int32_t const& y0, std::int32_t const& x1, std::int32_t const& y1) -> void {
+    auto const width  = image.width();
+    auto const escape = kernel(width);
+    auto const grid   = view_grid(m_view, width, image.height());
+    auto const max_iterations = m_view.max_iterations;
+
+    auto const first = x0 + pass.x0;
+    if (first >= x1) return;
+    auto const count = (x1 - first + pass.dx - 1) / pass.dx;
+    auto const is_float = image.format() == mno::pixel_format::r32f;
+    thread_local std::vector<std::uint32_t> samples{};
+    samples.resize(std::size_t(count));
+
+    for (auto y = y0 + pass.y0; y < y1; y += pass.dy) {
+        auto row = m_iterations.data() + std::size_t(y) * std::size_t(width);
+        auto const sample = [&](std::int32_t const& i) -> std::uint32_t& { return row[first + i * pass.dx]; };
+        // Runs of missing samples go through the kernel in one call, counts
+        // that were reused or loaded are kept
+        for (std::int32_t i = 0; i < count;) {
+            if (sample(i) != missing_count) {
+                i++;
+                continue;
+            }
+            auto end = i + 1;
+            while (end < count && sample(end) == missing_count) end++;
+            escape(grid.pixel, coordinate(grid.pixel, grid.y0 + y), grid.x0 + first + i * pass.dx, pass.dx,
+                   end - i, max_iterations, samples.data() + i);
+            for (auto j = i; j < end; j++) {
+                sample(j) = samples[std::size_t(j)];
+                mark_rendered(image, first + j * pass.dx, y, first + j * pass.dx + 1);
+            }
+            i = end;
+        }
+
+        // Every sample stands in for the missing pixels of its block until a
+        // later pass renders them, only the image sees the stand-ins
+        auto const block_y1 = std::min(y + pass.block_height, y1);
+        for (auto by = y; by < block_y1; by++) {
+            auto const* counts = m_iterations.data() + std::size_t(by) * std::size_t(width);
+            for (std::int32_t i = 0; i < count; i++) {
+                auto const bx0 = first + i * pass.dx;
+                auto const bx1 = std::min(bx0 + pass.block_width, x1);
+                auto const n   = sample(i);
+                if (is_float) {
+                    auto out = image.row<mno::f32>(by, bx0, bx1);
+                    for (auto x = bx0; x < bx1; x++)
+                        out[std::size_t(x - bx0)] = mno::f32(counts[x] == missing_count ? n : counts[x]);
+                } else {
+                    for (auto x = bx0; x < bx1; x++)
+                        image.set(x, by, color(counts[x] == missing_count ? n : counts[x], max_iterations));
+                }
+            }
+        }
+    }
+}
+
+auto mandelbrot::reproject(mandelbrot_view const& view, mno::image const& image) -> std::size_t {
+    auto const width  = image.width();
+    auto const height = image.height();
+    auto const size   = std::size_t(width) * std::size_t(height);
+    m_rendered.assign(size, 0);
+    // Rows of the old counts only line up when the shape is the same
+    auto const is_reshaped = m_width != width || m_height != height || m_iterations.size() != size;
+    m_width  = width;
+    m_height = height;
+    if (is_reshaped) {
+        m_view = view;
+        m_iterations.assign(size, missing_count);
+        return size;
+    }
+    auto const from_precision = resolve_precision(width);
+    auto const from = m_view;
+    m_view = view;
+
+    // Counts are only reused when every kernel input of the pixel matches
+    auto const old_grid = view_grid(from, width, height);
+    auto const grid     = view_grid(view, width, height);
+    auto octaves = 0;
+    auto const mantissa = std::frexp(grid.pixel / old_grid.pixel, &octaves);
+    octaves--;
+    auto const is_exact = mantissa == 0.5 && std::abs(octaves) <= max_reuse_octaves &&
+                          std::ldexp(old_grid.pixel, octaves) == grid.pixel;
+    if (from.max_iterations != view.max_iterations || from_precision != resolve_precision(width) || !is_exact) {
+        m_iterations.assign(size, missing_count);
+        return size;
+    }
+    std::swap(m_iterations, m_previous);
+    m_iterations.assign(size, missing_count);
+
+    std::vector<std::int32_t> columns(std::size_t(width), -1);
+    for (std::int32_t x = 0; x < width; x++)
+        columns[std::size_t(x)] = reused_index(grid.x0 + x, octaves, old_grid.x0, width);
+    std::size_t reused = 0;
+    for (std::int32_t y = 0; y < height; y++) {
+        auto const old_y = reused_index(grid.y0 + y, octaves, old_grid.y0, height);
+        if (old_y < 0) continue;
+        auto const* src = m_previous.data() + std::size_t(old_y) * std::size_t(width);
+        auto* dst = m_iterations.data() + std::size_t(y) * std::size_t(width);
+        for (std::int32_t x = 0; x < width; x++) {
+            auto const old_x = columns[std::size_t(x)];
+            if (old_x < 0 || src[old_x] == missing_count) continue;
+            dst[x] = src[old_x];
+            reused++;
+        }
+    }
+    return size - reused;
+}
+
+auto mandelbrot::render_missing(mno::image& image, std::int32_t const& x0, std::int32_t const& y0,
+                                std::int32_t const& x1, std::int32_t const& y1) -> void {
+    auto const width  = image.width();
+    auto const escape = kernel(width);
+    auto const grid   = view_grid(m_view, width, image.height());
+    for (auto y = y0; y < y1; y++) {
+        auto row = m_iterations.data() + std::size_t(y) * std::size_t(width);
+        // Runs of missing pixels go through the kernel in one call
+        for (auto x = x0; x < x1;) {
+            if (row[x] != missing_count) {
+                x++;
+                continue;
+            }
+            auto end = x + 1;
+            while (end < x1 && row[end] == missing_count) end++;
+            escape(grid.pixel, coordinate(grid.pixel, grid.y0 + y), grid.x0 + x, 1, end - x,
+                   m_view.max_iterations, row + x);
+            mark_rendered(image, x, y, end);
+            x = end;
+        }
+    }
+    write(image, x0, y0, x1, y1);
+}
+
+auto mandelbrot::write(mno::image& image, std::int32_t const& x0, std::int32_t const& y0,
+                       std::int32_t const& x1, std::int32_t const& y1) const -> void {
+    auto const width = image.width();
+    for (auto y = y0; y < y1; y++) {
+        auto const* row = m_iterations.data() + std::size_t(y) * std::size_t(width);
+        if (image.format() == mno::pixel_format::r32f) {
+            auto out = image.row<mno::f32>(y, x0, x1);
+            for (std::size_t i = 0; i < out.size(); i++) out[i] = mno::f32(row[std::size_t(x0) + i]);
+        } else {
+            for (auto x = x0; x < x1; x++) image.set(x, y, color(row[x], m_view.max_iterations));
+        }
+    }
+}
+
+auto mandelbrot::load(mno::image& image, tile_cache& cache, std::int32_t const& x0, std::int32_t const& y0,
+                      std::int32_t const& x1, std::int32_t const& y1) -> bool {
+    thread_local std::vector<mno::f32> values{};
+    if (!cache.load(cache_key(image, x0, y0, x1, y1), values)) return false;
+    auto const columns = std::size_t(x1 - x0);
+    if (values.size() != columns * std::size_t(y1 - y0)) return false;
+    for (auto y = y0; y < y1; y++) {
+        auto row = m_iterations.data() + std::size_t(y) * std::size_t(image.width()) + x0;
+        auto const* src = values.data() + std::size_t(y - y0) * columns;
+        for (std::size_t i = 0; i < columns; i++) row[i] = std::uint32_t(src[i]);
+        auto rendered = m_rendered.data() + std::size_t(y) * std::size_t(image.width());
+        std::fill(rendered + x0, rendered + x1, std::uint8_t(0));
+    }
+    write(image, x0, y0, x1, y1);
+    return true;
+}
+
+auto mandelbrot::store(mno::image const& image, tile_cache& cache, std::int32_t const& x0, std::int32_t const& y0,
+                       std::int32_t const& x1, std::int32_t const& y1) const -> bool {
+    auto is_rendered = false;
+    for (auto y = y0; y < y1 && !is_rendered; y++) {
+        auto const* rendered = m_rendered.data() + std::size_t(y) * std::size_t(image.width());
+        is_rendered = std::any_of(rendered + x0, rendered + x1, [](auto const& flag) { return flag != 0; });
+    }
+    if (!is_rendered) return false;
+
+    thread_local std::vector<mno::f32> values{};
+    values.clear();
+    for (auto y = y0; y < y1; y++) {
+        auto const* row = m_iterations.data() + std::size_t(y) * std::size_t(image.width());
+        for (auto x = x0; x < x1; x++) values.push_back(mno::f32(row[x]));
+    }
+    cache.store(cache_key(image, x0, y0, x1, y1), values);
+    return true;
+}
+
+auto mandelbrot::mark_rendered(mno::image const& image, std::int32_t const& x0, std::int32_t const& y,
+                               std::int32_t const& x1) -> void {
+    auto rendered = m_rendered.data() + std::size_t(y) * std::size_t(image.width());
+    std::fill(rendered + x0, rendered + x1, std::uint8_t(1));
+}
+
+auto mandelbrot::cache_key(mno::image const& image, std::int32_t const& x0, std::int32_t const& y0,
+                           std::int32_t const& x1, std::int32_t const& y1) const -> tile_key {
+    // Grid indices are exact, so a key always names the same pixel coordinates.
+    // Every SIMD level computes the same counts, the precision does not.
+    auto const grid = view_grid(m_view, image.width(), image.height());
+    auto const bits = resolve_precision(image.width()) == precision::f64 ? 64u : 32u;
+    return {mno::f64(grid.x0), mno::f64(grid.y0), m_view.scale, m_view.max_iterations, escape_formula::mandelbrot,
+            bits, kernel_revision, image.width(), image.height(), x0, y0, x1, y1};
+}
+
+auto mandelbrot::kernel(std::int32_t const& width) const -> mandelbrot_kernel {
+    return kernel(m_level, resolve_precision(width));
+}
+
+auto mandelbrot::kernel(mno::simd_level const& level, precision const& value) -> mandelbrot_kernel {
+    auto const is_f32 = value != precision::f64;
+#ifdef NRV_X86
+    if (level >= mno::simd_level::avx2) return is_f32 ? escape_avx2_f32 : escape_avx2_f64;
+    if (level >= mno::simd_level::sse2) return is_f32 ? escape_sse2_f32 : escape_sse2_f64;
+#else
+    (void)level;
+#endif
+    return is_f32 ? escape_scalar<mno::f32> : escape_scalar<mno::f64>;
+}
+
+auto mandelbrot::resolve_precision(std::int32_t const& width) const -> precision {
+    if (m_precision != precision::automatic) return m_precision;
+    // A float has 24 bits of mantissa, switch over before neighbouring pixels
+    // round to the same coordinate.
+    auto const pixel = m_view.scale / width;
+    auto const magnitude = std::max(std::abs(m_view.center_x), std::abs(m_view.center_y)) + m_view.scale;
+    return pixel < magnitude * 1e-6 ? precision::f64 : precision::f32;
+}
+
+auto mandelbrot::is_deep(mandelbrot_view const& view, std::int32_t const& width) -> bool {
+    auto const magnitude = std::max(std::abs(view.center_x), std::abs(view.center_y)) + view.scale;
+    return view.scale / width < magnitude * deep_zoom_limit;
+}
+
+auto mandelbrot::color(std::uint32_t const& iteration, std::uint32_t const& max_iterations) -> std::uint32_t {
+    if (iteration >= max_iterations) return 0x000000;
+    auto const t = mno::f64(iteration) / mno::f64(max_iterations);
+    auto const s = 1.0 - t;
+    auto const r = std::uint32_t(std::min( 9.0 * s * t * t * t, 1.0) * 255.0);
+    auto const g = std::uint32_t(std::min(15.0 * s * s * t * t, 1.0) * 255.0);
+    auto const b = std::uint32_t(std::min( 8.5 * s * s * s * t, 1.0) * 255.0);
+    return r << 16 | g << 8 | b;
+}
+
+auto mandelbrot::str() const -> std::string {
+    std::string str{"nrv::mandelbrot { "};
+    str += "center: [" + std::to_string(m_view.center_x) + ", " + std::to_string(m_view.center_y) + "], ";
+    str += "scale: " + std::to_string(m_view.scale) + ", ";
+    str += "max_iterations: " + std::to_string(m_view.max_iterations) + ", ";
+    str += "simd: " + mno::to_string(m_level) + " }";
+    return str;
+}
+}  // namespace nrv
@@ -0,0 +1,143 @@
+/**
+ * @file   mandelbrot.hpp
+ * @author Pratchaya Khansomboon (me@mononerv.dev)
+ * @brief  CPU Mandelbrot escape-time renderer with SIMD kernels.
+ * @date   2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ */
+#ifndef NRV_MANDELBROT_HPP
+#define NRV_MANDELBROT_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "mono/common.hpp"
+#include "mono/cpu.hpp"
+#include "mono/image.hpp"
+#include "mono/tile_scheduler.hpp"
+
+#include "progressive.hpp"
+#include "tile_cache.hpp"
+
+namespace nrv {
+struct mandelbrot_view {
+    mno::f64      center_x       = -0.5;
+    mno::f64      center_y       =  0.0;
+    mno::f64      scale          =  3.0;  // view width in the complex plane
+    std::uint32_t max_iterations =  256;
+
+    auto operator==(mandelbrot_view const&) const -> bool = default;
+};
+
+// Computes escape-time counts for grid indices x0 + i dx, i < count, of the
+// row at imaginary part y. Index x sits at real part x pixel, indices stay
+// integers so every call computes a pixel's coordinate the same way.
+using mandelbrot_kernel = auto (*)(mno::f64 pixel, mno::f64 y, std::int64_t x0, std::int32_t dx,
+                                   std::int32_t count, std::uint32_t max_iterations, std::uint32_t* out) -> void;
+
+class mandelbrot {
+  public:
+    // Smallest pixel size relative to the centre's magnitude that f64 still
+    // resolves with a few hundred ulps to spare.
+    static constexpr mno::f64 deep_zoom_limit = 1e-13;
+    // Goes up whenever a kernel's counts change, cached tiles of another
+    // revision are misses.
+    static constexpr std::uint32_t kernel_revision = 2;
+
+    // automatic picks f32 while the pixel spacing is representable in a float.
+    enum class precision : std::uint32_t {
+        automatic = 0,
+        f32,
+        f64,
+    };
+
+  public:
+    explicit mandelbrot(mandelbrot_view const& view = {},
+                        mno::simd_level const& level = mno::cpu_simd_level());
+    ~mandelbrot() = default;
+
+    auto set_view(mandelbrot_view const& view) -> void { m_view = view; }
+    auto view() const -> mandelbrot_view const& { return m_view; }
+    auto set_precision(precision const& value) -> void { m_precision = value; }
+    auto set_simd_level(mno::simd_level const& level) -> void { m_level = level; }
+    auto simd_level() const -> mno::simd_level { return m_level; }
+
+    // Render the whole image, escape counts are kept in iterations(). An r32f
+    // image receives the counts instead of colours.
+    auto render(mno::image& image) -> void;
+    // Render the whole image with the tiles spread over the scheduler's threads.
+    auto render(mno::image& image, mno::tile_scheduler& scheduler) -> void;
+    // Size the iteration buffer for image and mark every pixel missing, call
+    // before rendering rectangles or passes.
+    auto prepare(mno::image const& image) -> void;
+    // Render only the rectangle [x0, x1) x [y0, y1) of the image, safe to
+    // call concurrently for disjoint rectangles after prepare().
+    auto render(mno::image& image, std::int32_t const& x0, std::int32_t const& y0,
+                std::int32_t const& x1, std::int32_t const& y1) -> void;
+
+    // Render the missing samples of an interlaced pass inside the rectangle,
+    // x0 and y0 must be multiples of interlace_cell. Each sample's block
+    // shows its count in the image until later passes render the block's
+    // missing pixels, counts that were reused or loaded are kept. Driven by
+    // nrv::progressive after prepare() or reproject().
+    auto render(mno::image& image, interlace_pass const& pass, std::int32_t const& x0, std::int32_t const& y0,
+                std::int32_t const& x1, std::int32_t const& y1) -> void;
+
+    // Switch to view keeping the escape counts that stay exact. Pixels sit on
+    // a grid of whole multiples of the pixel size, so pans keep every pixel
+    // that stays visible and zooms by powers of two keep the pixels whose
+    // grid points coincide. Every other pixel is marked missing and the
+    // number of them returned. Needs an image of the width and height the
+    // counts were rendered at, otherwise everything is missing.
+    auto reproject(mandelbrot_view const& view, mno::image const& image) -> std::size_t;
+    // Render the missing pixels of the rectangle and rewrite the image there,
+    // reused counts have moved so every pixel of the rectangle is written.
+    auto render_missing(mno::image& image, std::int32_t const& x0, std::int32_t const& y0,
+                        std::int32_t const& x1, std::int32_t const& y1) -> void;
+
+    // Fill the rectangle from the cache without computing anything, false
+    // and nothing written on a miss. Call after prepare().
+    auto load(mno::image& image, tile_cache& cache, std::int32_t const& x0, std::int32_t const& y0,
+              std::int32_t const& x1, std::int32_t const& y1) -> bool;
+    // Cache the escape counts of a finished rectangle that holds pixels
+    // rendered since the last prepare() or reproject(). Rectangles of only
+    // loaded or reused counts are skipped, false then.
+    auto store(mno::image const& image, tile_cache& cache, std::int32_t const& x0, std::int32_t const& y0,
+               std::int32_t const& x1, std::int32_t const& y1) const -> bool;
+    auto cache_key(mno::image const& image, std::int32_t const& x0, std::int32_t const& y0,
+                   std::int32_t const& x1, std::int32_t const& y1) const -> tile_key;
+
+    auto iterations() const -> std::vector<std::uint32_t> const& { return m_iterations; }
+    auto kernel(std::int32_t const& width) const -> mandelbrot_kernel;
+
+    [[nodiscard]] auto str() const -> std::string;
+
+  public:
+    static auto kernel(mno::simd_level const& level, precision const& value) -> mandelbrot_kernel;
+    static auto color(std::uint32_t const& iteration, std::uint32_t const& max_iterations) -> std::uint32_t;
+    // True once f64 pixel coordinates get too coarse for the view, past that
+    // neighbouring pixels collapse and the view needs nrv::perturbation.
+    static auto is_deep(mandelbrot_view const& view, std::int32_t const& width) -> bool;
+
+  private:
+    auto resolve_precision(std::int32_t const& width) const -> precision;
+    auto write(mno::image& image, std::int32_t const& x0, std::int32_t const& y0,
+               std::int32_t const& x1, std::int32_t const& y1) const -> void;
+    auto mark_rendered(mno::image const& image, std::int32_t const& x0, std::int32_t const& y,
+                       std::int32_t const& x1) -> void;
+
+  private:
+    mandelbrot_view             m_view{};
+    mno::simd_level             m_level{mno::simd_level::scalar};
+    precision                   m_precision{precision::automatic};
+    std::vector<std::uint32_t>  m_iterations{};
+    std::int32_t                m_width{0};   // image size m_iterations was rendered at
+    std::int32_t                m_height{0};
+    std::vector<std::uint32_t>  m_previous{};  // counts before reproject()
+    std::vector<std::uint8_t>   m_rendered{};  // 1 where the kernel ran since prepare() or reproject()
+};
+}  // namespace nrv
+
+#endif // NRV_MANDELBROT_HPP
@@ -0,0 +1,248 @@
+/**
+ * @file   perturbation.cpp
+ * @author Pratchaya Khansomboon (me@mononerv.dev)
+ * @brief  Deep zoom Mandelbrot renderer using perturbation theory.
+ * @date   2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ */
+#include "perturbation.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+#include "bignum.hpp"
+
+namespace nrv {
+// Enough fraction bits to resolve the view plus headroom for the pixel grid
+static auto view_precision(mno::f64 const& scale) -> std::uint32_t {
+    return std::uint32_t(std::max(0.0, -std::log2(scale))) + 64;
+}
+
+auto deep_zoom_view_of(mandelbrot_view const& view) -> deep_zoom_view {
+    auto const limbs = bignum::limbs_for_bits(view_precision(view.scale));
+    return {bignum{view.center_x, limbs}.str(), bignum{view.center_y, limbs}.str(), view.scale, view.max_iterations};
+}
+
+auto mandelbrot_view_of(deep_zoom_view const& view) -> mandelbrot_view {
+    auto const limbs = bignum::limbs_for_bits(view_precision(view.scale));
+    return {bignum{view.center_x, limbs}.to_f64(), bignum{view.center_y, limbs}.to_f64(), view.scale,
+            view.max_iterations};
+}
+
+auto pan(deep_zoom_view const& view, mno::f64 const& dx, mno::f64 const& dy) -> deep_zoom_view {
+    auto const limbs = bignum::limbs_for_bits(view_precision(view.scale));
+    auto moved = view;
+    moved.center_x = (bignum{view.center_x, limbs} + bignum{dx, limbs}).str();
+    moved.center_y = (bignum{view.center_y, limbs} + bignum{dy, limbs}).str();
+    return moved;
+}
+
+perturbation::perturbation(deep_zoom_view const& view) : m_view(view) {}
+
+auto perturbation::set_view(deep_zoom_view const& view) -> void {
+    m_dirty = m_dirty || view.center_x != m_view.center_x || view.center_y != m_view.center_y ||
+              view.scale != m_view.scale || view.max_iterations != m_view.max_iterations;
+    m_series_dirty = m_series_dirty || m_dirty;
+    m_view = view;
+}
+
+auto perturbation::set_series_approximation(bool const& enable) -> void {
+    m_series_dirty = m_series_dirty || enable != m_series;
+    m_series = enable;
+}
+
+auto perturbation::render(mno::image& image) -> void {
+    prepare(image);
+    render(image, 0, 0, image.width(), image.height());
+}
+
+auto perturbation::render(mno::image& image, mno::tile_scheduler& scheduler) -> void {
+    prepare(image);
+    scheduler.run(image, [&](mno::tile const& t) {
+        render(image, t.x0, t.y0, t.x1, t.y1);
+    });
+}
+
+auto perturbation::prepare(mno::image const& image) -> void {
+    if (m_dirty) compute_reference();
+    if (m_series_dirty || m_series_width != image.width() || m_series_height != image.height())
+        compute_series(image.width(), image.height());
+    m_iterations.resize(std::size_t(image.width()) * std::size_t(image.height()));
+    m_rebases.store(0, std::memory_order_relaxed);
+}
+
+auto perturbation::render(mno::image& image, std::int32_t const& x0, std::int32_t const& y0,
+                          std::int32_t const& x1, std::int32_t const& y1) -> void {
+    auto const width  = image.width();
+    auto const height = image.height();
+    auto const max_iterations = m_view.max_iterations;
+    auto const pixel = m_view.scale / width;
+    auto const* ref  = m_reference.data();
+    auto const last  = m_reference.size() - 1;
+    auto const skip  = m_skip;
+    auto const term  = skip > 0 ? m_series_terms[skip] : series_term{};
+
+    std::uint64_t rebases = 0;
+    for (auto y = y0; y < y1; y++) {
+        auto const dci = (y + 0.5 - height * 0.5) * pixel;
+        auto row = m_iterations.data() + std::size_t(y) * std::size_t(width);
+        for (auto x = x0; x < x1; x++) {
+            auto const dcr = (x + 0.5 - width * 0.5) * pixel;
+            mno::f64 dr = 0.0, di = 0.0;
+            std::size_t m = 0;
+            std::uint32_t n = 0;
+            if (skip > 0) {
+                auto const u = std::complex<mno::f64>{dcr, dci} / m_series_radius;
+                auto const d = ((term.c * u + term.b) * u + term.a) * u;
+                auto const xr = ref[skip].re + d.real();
+                auto const xi = ref[skip].im + d.imag();
+                // Pixels that escape before the skip iterate from the start
+                if (xr * xr + xi * xi < 4.0) {
+                    dr = d.real();
+                    di = d.imag();
+                    m  = skip;
+                    n  = skip;
+                }
+            }
+            while (n < max_iterations) {
+                auto const zr = ref[m].re;
+                auto const zi = ref[m].im;
+                auto const nr = 2.0 * (zr * dr - zi * di) + dr * dr - di * di + dcr;
+                auto const ni = 2.0 * (zr * di + zi * dr) + 2.0 * dr * di + dci;
+                dr = nr;
+                di = ni;
+                m++;
+
+                auto const xr  = ref[m].re + dr;
+                auto const xi  = ref[m].im + di;
+                auto const mag = xr * xr + xi * xi;
+                if (!(mag < 4.0)) break;
+                n++;
+
+                // Glitch or end of reference, continue from Z(0) = 0 with z as delta
+                if (mag < ref[m].glitch || mag < dr * dr + di * di || m == last) {
+                    dr = xr;
+                    di = xi;
+                    m  = 0;
+                    rebases++;
+                }
+            }
+            row[x] = n;
+        }
+        // Float images keep the raw counts so the colour map can run on the GPU
+        if (image.format() == mno::pixel_format::r32f) {
+            auto out = image.row<mno::f32>(y, x0, x1);
+            for (std::size_t i = 0; i < out.size(); i++) out[i] = mno::f32(row[std::size_t(x0) + i]);
+        } else {
+            for (auto x = x0; x < x1; x++) image.set(x, y, mandelbrot::color(row[x], max_iterations));
+        }
+    }
+    m_rebases.fetch_add(rebases, std::memory_order_relaxed);
+}
+
+auto perturbation::compute_reference() -> void {
+    m_precision = view_precision(m_view.scale);
+    auto const limbs = bignum::limbs_for_bits(m_precision);
+
+    bignum const cr{m_view.center_x, limbs};
+    bignum const ci{m_view.center_y, limbs};
+    bignum zr{limbs};
+    bignum zi{limbs};
+
+    m_reference.clear();
+    m_reference.push_back({0.0, 0.0, 0.0});
+    for (std::uint32_t n = 0; n < m_view.max_iterations; n++) {
+        auto const zr2 = zr * zr;
+        auto const zi2 = zi * zi;
+        auto const zri = zr * zi;
+        zi = zri + zri + ci;
+        zr = zr2 - zi2 + cr;
+
+        auto const re  = zr.to_f64();
+        auto const im  = zi.to_f64();
+        auto const mag = re * re + im * im;
+        m_reference.push_back({re, im, glitch_tolerance * mag});
+        if (mag > 4.0) break;
+    }
+    m_dirty = false;
+    m_series_dirty = true;
+}
+
+auto perturbation::compute_series(std::int32_t const& width, std::int32_t const& height) -> void {
+    using complex = std::complex<mno::f64>;
+    m_series_width  = width;
+    m_series_height = height;
+    m_series_dirty  = false;
+    m_series_terms.clear();
+    m_skip = 0;
+    if (!m_series || m_reference.size() < 3 || width <= 0 || height <= 0) return;
+
+    auto const pixel  = m_view.scale / width;
+    auto const rx     = width  * 0.5 * pixel;
+    auto const ry     = height * 0.5 * pixel;
+    auto const radius = std::hypot(rx, ry);
+    m_series_radius   = radius;
+
+    // d(1) = dc, so A(1) = |dc|max after scaling
+    m_series_terms.push_back({});
+    m_series_terms.push_back({complex{radius, 0.0}, {}, {}});
+    auto const last = m_reference.size() - 1;
+    for (std::size_t n = 1; n + 1 < last; n++) {
+        auto const z = 2.0 * complex{m_reference[n].re, m_reference[n].im};
+        auto const& t = m_series_terms.back();
+        series_term const next{
+            z * t.a + radius,
+            z * t.b + t.a * t.a,
+            z * t.c + 2.0 * t.a * t.b,
+        };
+        if (!(std::abs(next.c) <= series_tolerance * std::abs(next.a))) break;
+        m_series_terms.push_back(next);
+    }
+
+    // The truncation estimate is only a heuristic, check it against pixels
+    // iterated the normal way at the corners and edges of the view.
+    complex const probes[] {
+        {-rx, -ry}, {0.0, -ry}, {rx, -ry},
+        {-rx, 0.0},             {rx, 0.0},
+        {-rx,  ry}, {0.0,  ry}, {rx,  ry},
+    };
+    auto skip = std::uint32_t(m_series_terms.size() - 1);
+    while (skip > 1 && !is_series_valid(skip, radius, probes, std::size(probes))) skip /= 2;
+    m_skip = skip > 1 ? skip : 0;
+}
+
+auto perturbation::is_series_valid(std::uint32_t const& skip, mno::f64 const& radius,
+                                   std::complex<mno::f64> const* probes, std::size_t const& count) const -> bool {
+    using complex = std::complex<mno::f64>;
+    auto const& term = m_series_terms[skip];
+    for (std::size_t i = 0; i < count; i++) {
+        auto const dc = probes[i];
+        complex d{};
+        for (std::uint32_t n = 0; n < skip; n++) {
+            auto const z = complex{m_reference[n].re, m_reference[n].im};
+            d = 2.0 * z * d + d * d + dc;
+            if (std::norm(complex{m_reference[n + 1].re, m_reference[n + 1].im} + d) >= 4.0) return false;
+        }
+        auto const u = dc / radius;
+        auto const approx = ((term.c * u + term.b) * u + term.a) * u;
+        if (std::abs(approx - d) > probe_tolerance * std::abs(d)) return false;
+    }
+    return true;
+}
+
+auto perturbation::str() const -> std::string {
+    std::ostringstream scale;
+    scale << m_view.scale;
+    std::string str{"nrv::perturbation { "};
+    str += "center: [" + m_view.center_x + ", " + m_view.center_y + "], ";
+    str += "scale: " + scale.str() + ", ";
+    str += "precision: " + std::to_string(m_precision) + ", ";
+    str += "series: " + std::string(m_series ? "on" : "off") + ", ";
+    str += "skipped: " + std::to_string(m_skip) + ", ";
+    str += "rebases: " + std::to_string(rebases()) + ", ";
+    str += "reference: " + std::to_string(m_reference.size()) + " }";
+    return str;
+}
+}  // namespace nrv
@@ -0,0 +1,135 @@
+/**
+ * @file   perturbation.hpp
+ * @author Pratchaya Khansomboon (me@mononerv.dev)
+ * @brief  Deep zoom Mandelbrot renderer using perturbation theory.
+ * @date   2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ */
+#ifndef NRV_PERTURBATION_HPP
+#define NRV_PERTURBATION_HPP
+
+#include <cstdint>
+#include <atomic>
+#include <complex>
+#include <string>
+#include <vector>
+
+#include "mono/common.hpp"
+#include "mono/image.hpp"
+#include "mono/tile_scheduler.hpp"
+
+#include "mandelbrot.hpp"
+
+namespace nrv {
+// The center is kept as a decimal string since a double can't hold the
+// coordinates past a zoom of about 1e-15.
+struct deep_zoom_view {
+    std::string   center_x       = "-0.5";
+    std::string   center_y       = "0.0";
+    mno::f64      scale          = 3.0;  // view width in the complex plane
+    std::uint32_t max_iterations = 1024;
+};
+
+// Conversions for handing a view between nrv::mandelbrot and
+// nrv::perturbation, the centre keeps every bit of the double.
+[[nodiscard]] auto deep_zoom_view_of(mandelbrot_view const& view) -> deep_zoom_view;
+[[nodiscard]] auto mandelbrot_view_of(deep_zoom_view const& view) -> mandelbrot_view;
+// Moves the centre by (dx, dy) in the complex plane at the view's precision.
+[[nodiscard]] auto pan(deep_zoom_view const& view, mno::f64 const& dx, mno::f64 const& dy) -> deep_zoom_view;
+
+// One orbit point of the high precision reference, rounded to double.
+struct reference_point {
+    mno::f64 re;
+    mno::f64 im;
+    mno::f64 glitch;  // |Z|^2 scaled by the glitch tolerance
+};
+
+// Only the reference orbit at the view center is iterated in arbitrary
+// precision, every pixel follows it as a double delta:
+//
+//     d(n+1) = 2 Z(n) d(n) + d(n)^2 + dc
+//
+// A pixel whose orbit gets close to zero relative to the reference loses
+// all precision in the delta (a glitch), it is rebased by restarting the
+// delta at the start of the reference orbit with z itself as the delta.
+// Deltas are plain doubles which keeps zooms down to about 1e-290.
+//
+// Deep views spend most of their time in early iterations where every
+// pixel still follows the reference closely. A third order series
+//
+//     d(n) = A(n) dc + B(n) dc^2 + C(n) dc^3
+//
+// is iterated alongside the reference and every pixel starts at the last
+// iteration where the series is still accurate for the whole view.
+class perturbation {
+  public:
+    static constexpr mno::f64 glitch_tolerance = 1e-6;
+    // Largest |C dc^3| / |A dc| the series may reach before it stops.
+    static constexpr mno::f64 series_tolerance = 1e-9;
+    // Largest relative error allowed between the series and probe pixels.
+    static constexpr mno::f64 probe_tolerance  = 1e-6;
+
+  public:
+    explicit perturbation(deep_zoom_view const& view = {});
+    ~perturbation() = default;
+
+    auto set_view(deep_zoom_view const& view) -> void;
+    auto view() const -> deep_zoom_view const& { return m_view; }
+    auto set_series_approximation(bool const& enable) -> void;
+    auto is_series_approximation() const -> bool { return m_series; }
+
+    // An r32f image receives the escape counts instead of colours.
+    auto render(mno::image& image) -> void;
+    auto render(mno::image& image, mno::tile_scheduler& scheduler) -> void;
+    // Compute the reference orbit if the view changed and size the iteration buffer.
+    auto prepare(mno::image const& image) -> void;
+    // Render the rectangle [x0, x1) x [y0, y1), safe to call concurrently after prepare().
+    auto render(mno::image& image, std::int32_t const& x0, std::int32_t const& y0,
+                std::int32_t const& x1, std::int32_t const& y1) -> void;
+
+    auto iterations() const -> std::vector<std::uint32_t> const& { return m_iterations; }
+    auto reference() const -> std::vector<reference_point> const& { return m_reference; }
+    // Bits of fraction used for the reference orbit.
+    auto precision() const -> std::uint32_t { return m_precision; }
+    // Iterations every pixel skipped through the series approximation.
+    auto skipped() const -> std::uint32_t { return m_skip; }
+    // Number of rebases in the last render, a measure of how glitchy the view is.
+    auto rebases() const -> std::uint64_t { return m_rebases.load(std::memory_order_relaxed); }
+
+    [[nodiscard]] auto str() const -> std::string;
+
+  private:
+    // Coefficients scaled by powers of the largest |dc| in the view so they
+    // stay in double range, evaluated with u = dc / |dc|max.
+    struct series_term {
+        std::complex<mno::f64> a;
+        std::complex<mno::f64> b;
+        std::complex<mno::f64> c;
+    };
+
+    auto compute_reference() -> void;
+    auto compute_series(std::int32_t const& width, std::int32_t const& height) -> void;
+    auto is_series_valid(std::uint32_t const& skip, mno::f64 const& radius,
+                         std::complex<mno::f64> const* probes, std::size_t const& count) const -> bool;
+
+  private:
+    deep_zoom_view               m_view{};
+    bool                         m_dirty{true};
+    std::uint32_t                m_precision{0};
+    std::vector<reference_point> m_reference{};
+
+    bool                         m_series{true};
+    bool                         m_series_dirty{true};
+    std::int32_t                 m_series_width{0};
+    std::int32_t                 m_series_height{0};
+    mno::f64                     m_series_radius{0.0};
+    std::vector<series_term>     m_series_terms{};
+    std::uint32_t                m_skip{0};
+
+    std::vector<std::uint32_t>   m_iterations{};
+    std::atomic<std::uint64_t>   m_rebases{0};
+};
+}  // namespace nrv
+
+#endif // NRV_PERTURBATION_HPP
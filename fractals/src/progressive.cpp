@@ -0,0 +1,67 @@
+/**
+ * @file   progressive.cpp
+ * @author Pratchaya Khansomboon (me@mononerv.dev)
+ * @brief  Progressive refinement over interlaced pixel passes.
+ * @date   2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ */
+#include "progressive.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+namespace nrv {
+// Steps taken by a pass, each with 1/16 of the frame's samples.
+static auto band_count(interlace_pass const& pass) -> std::uint32_t {
+    return progressive::steps_per_frame / std::uint32_t(pass.dx * pass.dy);
+}
+
+auto progressive::pass() const -> std::size_t {
+    auto step = m_step;
+    for (std::size_t i = 0; i < interlace_passes.size(); i++) {
+        if (step < band_count(interlace_passes[i])) return i;
+        step -= band_count(interlace_passes[i]);
+    }
+    return interlace_passes.size();
+}
+
+auto progressive::run(std::int32_t const& width, std::int32_t const& height, mno::tile_scheduler& scheduler,
+                      mno::f64 const& budget_ms, pass_fn const& fn) -> std::uint32_t {
+    auto const start = std::chrono::steady_clock::now();
+    std::uint32_t count = 0;
+    while (!is_done()) {
+        step(width, height, scheduler, fn);
+        count++;
+        auto const elapsed = std::chrono::duration<mno::f64, std::milli>(std::chrono::steady_clock::now() - start);
+        if (elapsed.count() >= budget_ms) break;
+    }
+    return count;
+}
+
+auto progressive::step(std::int32_t const& width, std::int32_t const& height, mno::tile_scheduler& scheduler,
+                       pass_fn const& fn) -> void {
+    auto const index = pass();
+    auto const& current = interlace_passes[index];
+    auto band = m_step;
+    for (std::size_t i = 0; i < index; i++) band -= band_count(interlace_passes[i]);
+    m_step++;
+
+    // Bands are whole rows of cells so the blocks of a sample stay inside them
+    auto const bands = band_count(current);
+    auto const cells = (height + interlace_cell - 1) / interlace_cell;
+    auto const y0 = std::int32_t(std::int64_t(cells) * band / bands) * interlace_cell;
+    auto const y1 = std::min(std::int32_t(std::int64_t(cells) * (band + 1) / bands) * interlace_cell, height);
+    if (y0 >= y1) return;
+    scheduler.run(width, y1 - y0, [&](mno::tile const& tile) {
+        fn(current, {tile.x0, tile.y0 + y0, tile.x1, tile.y1 + y0, tile.index});
+    });
+}
+
+auto progressive::str() const -> std::string {
+    std::string str{"nrv::progressive { "};
+    str += "step: " + std::to_string(m_step) + "/" + std::to_string(steps_per_frame) + ", ";
+    str += "pass: " + std::to_string(pass()) + " }";
+    return str;
+}
+}  // namespace nrv
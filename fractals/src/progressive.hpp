@@ -0,0 +1,88 @@
+/**
+ * @file   progressive.hpp
+ * @author Pratchaya Khansomboon (me@mononerv.dev)
+ * @brief  Progressive refinement over interlaced pixel passes.
+ * @date   2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ */
+#ifndef NRV_PROGRESSIVE_HPP
+#define NRV_PROGRESSIVE_HPP
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+#include "mono/common.hpp"
+#include "mono/tile_scheduler.hpp"
+
+namespace nrv {
+// Pixels with x = x0 + i dx and y = y0 + j dy are sampled by the pass, each
+// sample stands in for the block_width x block_height block starting at it
+// until a later pass fills the block in.
+struct interlace_pass {
+    std::int32_t x0;
+    std::int32_t y0;
+    std::int32_t dx;
+    std::int32_t dy;
+    std::int32_t block_width;
+    std::int32_t block_height;
+};
+
+// Adam7 without its two 8x8 passes, the first pass samples one pixel in 16
+// and every later one doubles the samples so far. Each pixel is computed
+// exactly once over all passes.
+inline constexpr std::array<interlace_pass, 5> interlace_passes{{
+    {0, 0, 4, 4, 4, 4},
+    {2, 0, 4, 4, 2, 4},
+    {0, 2, 2, 4, 2, 2},
+    {1, 0, 2, 2, 1, 2},
+    {0, 1, 1, 2, 1, 1},
+}};
+// Passes start on rows and columns that are multiples of this.
+inline constexpr std::int32_t interlace_cell = 4;
+
+// Drives a renderer through the interlaced passes in steps of about 1/16 of
+// the frame's samples. Passes with more samples are split into horizontal
+// bands, so a step never takes much longer than the first pass and a
+// partial frame can be presented after every call to run().
+class progressive {
+  public:
+    // Renders the pass's samples inside the tile, tiles and bands start on
+    // multiples of interlace_cell so the blocks never cross tiles.
+    using pass_fn = std::function<void(interlace_pass const&, mno::tile const&)>;
+
+    static constexpr std::uint32_t steps_per_frame = 16;
+
+  public:
+    progressive() = default;
+    ~progressive() = default;
+
+    // Start over from the first pass, after the view or size changed.
+    auto restart() -> void { m_step = 0; }
+    // Skip the remaining steps, the frame came from elsewhere.
+    auto finish() -> void { m_step = steps_per_frame; }
+    auto is_done() const -> bool { return m_step >= steps_per_frame; }
+    // Fraction of the frame's samples rendered so far.
+    auto progress() const -> mno::f32 { return mno::f32(m_step) / mno::f32(steps_per_frame); }
+    // Index into interlace_passes of the next step.
+    auto pass() const -> std::size_t;
+
+    // Runs steps until budget_ms is spent or the frame is done, always at
+    // least one. Returns the number of steps run.
+    auto run(std::int32_t const& width, std::int32_t const& height, mno::tile_scheduler& scheduler,
+             mno::f64 const& budget_ms, pass_fn const& fn) -> std::uint32_t;
+
+    [[nodiscard]] auto str() const -> std::string;
+
+  private:
+    auto step(std::int32_t const& width, std::int32_t const& height, mno::tile_scheduler& scheduler,
+              pass_fn const& fn) -> void;
+
+  private:
+    std::uint32_t m_step{0};
+};
+}  // namespace nrv
+
+#endif // NRV_PROGRESSIVE_HPP
@@ -0,0 +1,337 @@
+/**
+ * @file   tile_cache.cpp
+ * @author Pratchaya Khansomboon (me@mononerv.dev)
+ * @brief  In-memory LRU and on-disk cache of escape-time tiles.
+ * @date   2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ */
+#include "tile_cache.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <system_error>
+#include <utility>
+
+#ifdef _WIN32
+#include <iterator>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "spdlog/spdlog.h"
+
+namespace nrv {
+// Tile file layout: header followed by count floats.
+static constexpr std::uint32_t tile_magic   = 0x43544E4D;  // "MNTC"
+static constexpr std::uint32_t tile_version = 2;
+
+struct tile_header {
+    std::uint32_t magic;
+    std::uint32_t version;
+    tile_key      key;
+    std::uint64_t count;
+};
+static_assert(sizeof(tile_header) == 80, "tile_header must not have padding");
+
+tile_cache::tile_cache(std::filesystem::path const& directory, std::size_t const& memory_bytes,
+                       std::size_t const& disk_bytes)
+    : m_directory(directory), m_capacity(memory_bytes), m_disk_capacity(disk_bytes) {
+    if (m_directory.empty()) return;
+    std::error_code error;
+    std::filesystem::create_directories(m_directory, error);
+    if (error) spdlog::warn("TILE::CACHE failed to create {}: {}", m_directory.string(), error.message());
+    scan();
+    m_writer = std::thread([this] { writer(); });
+}
+
+tile_cache::~tile_cache() {
+    {
+        std::scoped_lock lock{m_mutex};
+        m_stop = true;
+    }
+    m_queued.notify_all();
+    if (m_writer.joinable()) m_writer.join();
+}
+
+auto tile_cache::load(tile_key const& key, std::vector<mno::f32>& values) -> bool {
+    auto const id = hash(key);
+    {
+        std::scoped_lock lock{m_mutex};
+        auto const it = m_index.find(id);
+        if (it != std::end(m_index) && it->second->key == key) {
+            m_entries.splice(std::begin(m_entries), m_entries, it->second);
+            values = it->second->values;
+            touch(id);
+            m_hits++;
+            return true;
+        }
+    }
+    auto const is_found = !m_directory.empty() && read(path(id), key, values);
+    std::scoped_lock lock{m_mutex};
+    if (is_found) {
+        insert(key, id, values);
+        touch(id);
+        m_hits++;
+    } else {
+        m_misses++;
+    }
+    return is_found;
+}
+
+auto tile_cache::store(tile_key const& key, std::vector<mno::f32> const& values) -> void {
+    auto const id = hash(key);
+    {
+        std::scoped_lock lock{m_mutex};
+        insert(key, id, values);
+        if (!m_directory.empty()) m_queue.push_back({key, values});
+    }
+    if (!m_directory.empty()) m_queued.notify_one();
+}
+
+auto tile_cache::clear() -> void {
+    std::scoped_lock lock{m_mutex};
+    m_entries.clear();
+    m_index.clear();
+    m_bytes = 0;
+}
+
+auto tile_cache::flush() -> void {
+    std::unique_lock lock{m_mutex};
+    m_written.wait(lock, [&] { return m_queue.empty() && !m_is_writing; });
+}
+
+auto tile_cache::memory_bytes() const -> std::size_t {
+    std::scoped_lock lock{m_mutex};
+    return m_bytes;
+}
+auto tile_cache::disk_bytes() const -> std::size_t {
+    std::scoped_lock lock{m_mutex};
+    return m_disk_bytes;
+}
+auto tile_cache::hits() const -> std::uint64_t {
+    std::scoped_lock lock{m_mutex};
+    return m_hits;
+}
+auto tile_cache::misses() const -> std::uint64_t {
+    std::scoped_lock lock{m_mutex};
+    return m_misses;
+}
+
+auto tile_cache::hash(tile_key const& key) -> std::uint64_t {
+    // FNV-1a over the key's bytes
+    unsigned char bytes[sizeof(tile_key)];
+    std::memcpy(bytes, &key, sizeof(key));
+    auto hash = 0xCBF29CE484222325ull;
+    for (auto const& byte : bytes) {
+        hash ^= std::uint64_t(byte);
+        hash *= 0x100000001B3ull;
+    }
+    return hash;
+}
+
+auto tile_cache::path(std::uint64_t const& hash) const -> std::filesystem::path {
+    constexpr char digits[] = "0123456789abcdef";
+    std::string name(16, '0');
+    auto value = hash;
+    for (auto i = name.size(); i-- > 0; value >>= 4) name[i] = digits[value & 0xF];
+    return m_directory / (name + ".tile");
+}
+
+auto tile_cache::insert(tile_key const& key, std::uint64_t const& hash, std::vector<mno::f32> const& values) -> void {
+    auto const it = m_index.find(hash);
+    if (it != std::end(m_index)) {
+        // Same key refreshed or a hash collision, the newer tile wins either way
+        m_bytes -= it->second->values.size() * sizeof(mno::f32);
+        m_entries.erase(it->second);
+        m_index.erase(it);
+    }
+    m_entries.push_front({key, values});
+    m_index.emplace(hash, std::begin(m_entries));
+    m_bytes += values.size() * sizeof(mno::f32);
+
+    while (m_bytes > m_capacity && m_entries.size() > 1) {
+        auto const& last = m_entries.back();
+        m_bytes -= last.values.size() * sizeof(mno::f32);
+        m_index.erase(tile_cache::hash(last.key));
+        m_entries.pop_back();
+    }
+}
+
+auto tile_cache::touch(std::uint64_t const& hash) -> void {
+    auto const it = m_file_index.find(hash);
+    if (it != std::end(m_file_index)) m_files.splice(std::begin(m_files), m_files, it->second);
+}
+
+auto tile_cache::scan() -> void {
+    struct found {
+        std::uint64_t                   hash;
+        std::size_t                     bytes;
+        std::filesystem::file_time_type time;
+    };
+    std::vector<found> files{};
+    std::vector<std::filesystem::path> leftovers{};
+    std::error_code error;
+    for (auto const& item : std::filesystem::directory_iterator{m_directory, error}) {
+        auto const& file = item.path();
+        if (file.extension() == ".tmp") {
+            // The writer was stopped mid-file, the tile was never renamed into place
+            leftovers.push_back(file);
+            continue;
+        }
+        if (file.extension() != ".tile") continue;
+        auto const name = file.stem().string();
+        if (name.size() != 16 || name.find_first_not_of("0123456789abcdef") != std::string::npos) continue;
+        std::error_code file_error;
+        auto const bytes = item.file_size(file_error);
+        auto const time  = item.last_write_time(file_error);
+        if (file_error) continue;
+        files.push_back({std::stoull(name, nullptr, 16), std::size_t(bytes), time});
+    }
+    if (error) spdlog::warn("TILE::CACHE failed to scan {}: {}", m_directory.string(), error.message());
+    for (auto const& file : leftovers) {
+        std::error_code file_error;
+        std::filesystem::remove(file, file_error);
+        if (file_error) spdlog::warn("TILE::CACHE failed to delete {}: {}", file.string(), file_error.message());
+    }
+
+    std::sort(std::begin(files), std::end(files), [](auto const& a, auto const& b) { return a.time > b.time; });
+    for (auto const& file : files) {
+        m_files.push_back({file.hash, file.bytes});
+        m_file_index.emplace(file.hash, std::prev(std::end(m_files)));
+        m_disk_bytes += file.bytes;
+    }
+    remove(evict());
+}
+
+auto tile_cache::evict() -> std::vector<std::uint64_t> {
+    std::vector<std::uint64_t> evicted{};
+    while (m_disk_bytes > m_disk_capacity && m_files.size() > 1) {
+        auto const& last = m_files.back();
+        m_disk_bytes -= last.bytes;
+        evicted.push_back(last.hash);
+        m_file_index.erase(last.hash);
+        m_files.pop_back();
+    }
+    return evicted;
+}
+
+auto tile_cache::remove(std::vector<std::uint64_t> const& hashes) const -> void {
+    for (auto const& id : hashes) {
+        std::error_code error;
+        std::filesystem::remove(path(id), error);
+        if (error) spdlog::warn("TILE::CACHE failed to delete {}: {}", path(id).string(), error.message());
+    }
+}
+
+auto tile_cache::writer() -> void {
+    std::unique_lock lock{m_mutex};
+    while (true) {
+        m_queued.wait(lock, [&] { return m_stop || !m_queue.empty(); });
+        if (m_queue.empty()) return;  // stopping with nothing left to write
+        auto tile = std::move(m_queue.front());
+        m_queue.pop_front();
+        m_is_writing = true;
+        lock.unlock();
+
+        auto const id    = hash(tile.key);
+        auto const bytes = sizeof(tile_header) + tile.values.size() * sizeof(mno::f32);
+        auto const is_written = write(path(id), tile.key, tile.values);
+
+        lock.lock();
+        std::vector<std::uint64_t> evicted{};
+        if (is_written) {
+            auto const it = m_file_index.find(id);
+            if (it != std::end(m_file_index)) {
+                m_disk_bytes -= it->second->bytes;
+                m_files.erase(it->second);
+                m_file_index.erase(it);
+            }
+            m_files.push_front({id, bytes});
+            m_file_index.emplace(id, std::begin(m_files));
+            m_disk_bytes += bytes;
+            evicted = evict();
+        }
+        lock.unlock();
+        remove(evicted);
+        lock.lock();
+        m_is_writing = false;
+        if (m_queue.empty()) m_written.notify_all();
+    }
+}
+
+auto tile_cache::read(std::filesystem::path const& file, tile_key const& key, std::vector<mno::f32>& values) const -> bool {
+    auto const is_valid = [&](unsigned char const* data, std::size_t const& size) {
+        if (size < sizeof(tile_header)) return false;
+        tile_header header{};
+        std::memcpy(&header, data, sizeof(header));
+        if (header.magic != tile_magic || header.version != tile_version || !(header.key == key)) return false;
+        if (header.count != (size - sizeof(header)) / sizeof(mno::f32)) return false;
+        values.resize(header.count);
+        std::memcpy(values.data(), data + sizeof(header), values.size() * sizeof(mno::f32));
+        return true;
+    };
+
+#ifdef _WIN32
+    std::ifstream input{file, std::ios::binary};
+    if (!input.is_open()) return false;
+    std::vector<unsigned char> data{std::istreambuf_iterator<char>{input}, std::istreambuf_iterator<char>{}};
+    return is_valid(data.data(), data.size());
+#else
+    auto const fd = ::open(file.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat info{};
+    if (::fstat(fd, &info) != 0 || info.st_size <= 0) {
+        ::close(fd);
+        return false;
+    }
+    auto const size = std::size_t(info.st_size);
+    auto* mapped = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED) return false;
+    auto const is_found = is_valid(static_cast<unsigned char const*>(mapped), size);
+    ::munmap(mapped, size);
+    return is_found;
+#endif
+}
+
+auto tile_cache::write(std::filesystem::path const& file, tile_key const& key, std::vector<mno::f32> const& values) const -> bool {
+    // Written to a temporary first so an interrupted write never leaves a truncated tile
+    auto temporary = file;
+    temporary += ".tmp";
+    std::error_code error;
+    {
+        std::ofstream output{temporary, std::ios::binary | std::ios::trunc};
+        tile_header const header{tile_magic, tile_version, key, values.size()};
+        output.write(reinterpret_cast<char const*>(&header), sizeof(header));
+        output.write(reinterpret_cast<char const*>(values.data()), std::streamsize(values.size() * sizeof(mno::f32)));
+        if (!output) {
+            spdlog::warn("TILE::CACHE failed to write {}", temporary.string());
+            output.close();
+            std::filesystem::remove(temporary, error);
+            return false;
+        }
+    }
+    std::filesystem::rename(temporary, file, error);
+    if (error) spdlog::warn("TILE::CACHE failed to write {}: {}", file.string(), error.message());
+    return !error;
+}
+
+auto tile_cache::str() const -> std::string {
+    std::scoped_lock lock{m_mutex};
+    std::string str{"nrv::tile_cache { "};
+    str += "directory: " + m_directory.string() + ", ";
+    str += "tiles: " + std::to_string(m_entries.size()) + ", ";
+    str += "bytes: " + std::to_string(m_bytes) + "/" + std::to_string(m_capacity) + ", ";
+    str += "files: " + std::to_string(m_files.size()) + ", ";
+    str += "disk_bytes: " + std::to_string(m_disk_bytes) + "/" + std::to_string(m_disk_capacity) + ", ";
+    str += "queued: " + std::to_string(m_queue.size()) + ", ";
+    str += "hits: " + std::to_string(m_hits) + ", ";
+    str += "misses: " + std::to_string(m_misses) + " }";
+    return str;
+}
+}  // namespace nrv
@@ -0,0 +1,163 @@
+/**
+ * @file   tile_cache.hpp
+ * @author Pratchaya Khansomboon (me@mononerv.dev)
+ * @brief  In-memory LRU and on-disk cache of escape-time tiles.
+ * @date   2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ */
+#ifndef NRV_TILE_CACHE_HPP
+#define NRV_TILE_CACHE_HPP
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <list>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "mono/common.hpp"
+
+namespace nrv {
+enum class escape_formula : std::uint32_t {
+    mandelbrot = 0,
+    perturbation,
+};
+
+// Identifies the escape counts of one tile. Tiles are keyed by their pixel
+// rectangle and the frame size, since the same tile index covers another
+// region at another tile size, and by everything else that changes the
+// counts: the coordinate precision and the revision of the kernels.
+struct tile_key {
+    mno::f64       center_x;  // rounded, in units the renderer picks
+    mno::f64       center_y;
+    mno::f64       scale;
+    std::uint32_t  max_iterations;
+    escape_formula formula;
+    std::uint32_t  precision;  // bits of the coordinates the counts were computed with
+    std::uint32_t  revision;   // kernel revision, counts of another revision differ
+    std::int32_t   width;
+    std::int32_t   height;
+    std::int32_t   x0;
+    std::int32_t   y0;
+    std::int32_t   x1;
+    std::int32_t   y1;
+
+    auto operator==(tile_key const&) const -> bool = default;
+};
+// Hashed and written to disk as raw bytes
+static_assert(std::is_trivially_copyable_v<tile_key> && sizeof(tile_key) == 64, "tile_key must not have padding");
+
+// Raw escape counts as floats, row after row, never colours, so a cached
+// tile can be recoloured without recomputing it.
+//
+// Recently used tiles stay in memory up to memory_bytes, least recently used
+// dropped first. Every stored tile is also written to its own file in the
+// cache directory, named after the key's hash, and misses in memory are
+// looked up there through mmap, so tiles survive restarts. Files carry
+// their full key and a mismatch is a miss. Deleting the directory is
+// always safe, an empty directory keeps the cache in memory only.
+//
+// Files are written by a background thread, store() only queues them. The
+// directory is kept under disk_bytes by deleting the least recently used
+// files, order across restarts follows the files' write times. Temporaries
+// left by a write that was cut short are deleted at startup.
+//
+// Safe to use from the tile scheduler's workers, disk access happens
+// outside the lock.
+class tile_cache {
+  public:
+    static constexpr std::size_t default_memory_bytes = 256ull << 20;
+    static constexpr std::size_t default_disk_bytes   = 1ull << 30;
+
+  public:
+    explicit tile_cache(std::filesystem::path const& directory = {},
+                        std::size_t const& memory_bytes = default_memory_bytes,
+                        std::size_t const& disk_bytes = default_disk_bytes);
+    // Finishes the queued writes.
+    ~tile_cache();
+
+    tile_cache(tile_cache const&) = delete;
+    auto operator=(tile_cache const&) -> tile_cache& = delete;
+
+    // Copies the tile's counts into values, false on a miss.
+    auto load(tile_key const& key, std::vector<mno::f32>& values) -> bool;
+    // Keeps the tile in memory and queues its file, never waits for the disk.
+    auto store(tile_key const& key, std::vector<mno::f32> const& values) -> void;
+    // Drops the tiles in memory, files on disk are kept.
+    auto clear() -> void;
+    // Blocks until every queued tile is on disk.
+    auto flush() -> void;
+
+    auto directory() const -> std::filesystem::path const& { return m_directory; }
+    auto memory_bytes() const -> std::size_t;
+    auto disk_bytes() const -> std::size_t;
+    auto hits() const -> std::uint64_t;
+    auto misses() const -> std::uint64_t;
+
+    [[nodiscard]] auto str() const -> std::string;
+
+  public:
+    static auto hash(tile_key const& key) -> std::uint64_t;
+
+  private:
+    struct entry {
+        tile_key              key;
+        std::vector<mno::f32> values;
+    };
+    using entry_list = std::list<entry>;
+    // Files on disk by hash, most recently used first.
+    struct file_entry {
+        std::uint64_t hash;
+        std::size_t   bytes;
+    };
+    using file_list = std::list<file_entry>;
+
+    auto path(std::uint64_t const& hash) const -> std::filesystem::path;
+    // Inserts or refreshes the entry, call with the lock held.
+    auto insert(tile_key const& key, std::uint64_t const& hash, std::vector<mno::f32> const& values) -> void;
+    // Marks the file as just used, call with the lock held.
+    auto touch(std::uint64_t const& hash) -> void;
+    // Adds the files already in the directory, oldest written last, and
+    // deletes temporaries of interrupted writes.
+    auto scan() -> void;
+    // Drops least recently used files past the disk budget, call with the
+    // lock held and remove() the returned files after releasing it.
+    auto evict() -> std::vector<std::uint64_t>;
+    auto remove(std::vector<std::uint64_t> const& hashes) const -> void;
+    auto writer() -> void;
+    auto read(std::filesystem::path const& file, tile_key const& key, std::vector<mno::f32>& values) const -> bool;
+    auto write(std::filesystem::path const& file, tile_key const& key, std::vector<mno::f32> const& values) const -> bool;
+
+  private:
+    std::filesystem::path                                     m_directory;
+    std::size_t                                               m_capacity;
+
+    mutable std::mutex                                        m_mutex{};
+    entry_list                                                m_entries{};  // most recently used first
+    std::unordered_map<std::uint64_t, entry_list::iterator>   m_index{};
+    std::size_t                                               m_bytes{0};
+    std::uint64_t                                             m_hits{0};
+    std::uint64_t                                             m_misses{0};
+
+    std::size_t                                               m_disk_capacity;
+    file_list                                                 m_files{};
+    std::unordered_map<std::uint64_t, file_list::iterator>    m_file_index{};
+    std::size_t                                               m_disk_bytes{0};
+
+    // Tiles waiting for the writer
+    std::deque<entry>                                         m_queue{};
+    std::condition_variable                                   m_queued{};
+    std::condition_variable                                   m_written{};
+    bool                                                      m_is_writing{false};
+    bool                                                      m_stop{false};
+    std::thread                                               m_writer{};
+};
+}  // namespace nrv
+
+#endif // NRV_TILE_CACHE_HPP
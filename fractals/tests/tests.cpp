@@ -0,0 +1,606 @@
+/**
+ * @file   tests.cpp
+ * @author Pratchaya Khansomboon (me@mononerv.dev)
+ * @brief  Consistency checks for the CPU fractal engines.
+ * @date   2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ */
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "mono/cpu.hpp"
+#include "mono/image.hpp"
+#include "mono/random.hpp"
+#include "mono/tile_scheduler.hpp"
+
+#include "bignum.hpp"
+#include "hashlife.hpp"
+#include "life.hpp"
+#include "mandelbrot.hpp"
+#include "perturbation.hpp"
+#include "progressive.hpp"
+#include "tile_cache.hpp"
+
+namespace nrv {
+struct test_case {
+    std::string           name;
+    std::function<void()> fn;
+};
+
+static auto check(bool const& condition, std::string const& message) -> void {
+    if (!condition) throw std::runtime_error(message);
+}
+
+// Views from the whole set down to where neighbouring pixels differ in the
+// last bits of a double, the rounding of pixel coordinates shows up there.
+static std::vector<mandelbrot_view> const mandelbrot_views{
+    {-0.5, 0.0, 3.0, 256},
+    {-0.743643887037151, 0.131825904205330, 1e-4, 512},
+    {-0.743643887037151, 0.131825904205330, 1e-9, 1024},
+};
+
+static auto simd_levels() -> std::vector<mno::simd_level> {
+    std::vector<mno::simd_level> levels{mno::simd_level::scalar};
+    for (auto const level : {mno::simd_level::sse2, mno::simd_level::avx2})
+        if (level <= mno::cpu_simd_level()) levels.push_back(level);
+    return levels;
+}
+
+// Number of pixels whose escape counts differ between a and b.
+static auto mismatches(std::vector<std::uint32_t> const& a, std::vector<std::uint32_t> const& b) -> std::size_t {
+    if (a.size() != b.size()) return std::max(a.size(), b.size());
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < a.size(); i++) count += a[i] != b[i];
+    return count;
+}
+
+static auto describe(mandelbrot_view const& view, mno::simd_level const& level) -> std::string {
+    char scale[32];
+    std::snprintf(scale, sizeof(scale), "%g", view.scale);
+    return "scale " + std::string(scale) + " on " + mno::to_string(level);
+}
+
+static auto test_progressive_matches_render() -> void {
+    constexpr std::int32_t width  = 640;
+    constexpr std::int32_t height = 360;
+    mno::tile_scheduler scheduler{};
+    for (auto const level : simd_levels()) {
+        for (auto const& view : mandelbrot_views) {
+            mno::image full{width, height, mno::pixel_format::r32f};
+            mandelbrot single{view, level};
+            single.render(full, scheduler);
+
+            mno::image image{width, height, mno::pixel_format::r32f};
+            mandelbrot refined{view, level};
+            refined.prepare(image);
+            progressive passes{};
+            while (!passes.is_done()) {
+                passes.run(width, height, scheduler, 1e9, [&](interlace_pass const& pass, mno::tile const& tile) {
+                    refined.render(image, pass, tile.x0, tile.y0, tile.x1, tile.y1);
+                });
+            }
+            auto const count = mismatches(single.iterations(), refined.iterations());
+            check(count == 0, std::to_string(count) + " pixels differ at " + describe(view, level));
+        }
+    }
+}
+
+// Every SIMD level computes the same counts as the scalar kernel, so a view
+// looks the same and the tile cache stays valid on any machine.
+static auto test_kernels_agree() -> void {
+    constexpr std::int32_t width  = 640;
+    constexpr std::int32_t height = 360;
+    mno::tile_scheduler scheduler{};
+    for (auto const& view : mandelbrot_views) {
+        mno::image image{width, height, mno::pixel_format::r32f};
+        mandelbrot scalar{view, mno::simd_level::scalar};
+        scalar.render(image, scheduler);
+        for (auto const level : simd_levels()) {
+            mandelbrot simd{view, level};
+            simd.render(image, scheduler);
+            auto const count = mismatches(scalar.iterations(), simd.iterations());
+            check(count == 0, std::to_string(count) + " pixels differ from scalar at " + describe(view, level));
+        }
+    }
+}
+
+// Pans by an eighth of the width and zooms by two from a deep view, as the
+// viewer does, each step filled in either by render_missing() or by the
+// passes. The counts must match a full render of the same view.
+static auto test_reproject_matches_render() -> void {
+    constexpr std::int32_t width  = 640;
+    constexpr std::int32_t height = 360;
+    constexpr auto pixels = std::size_t(width) * std::size_t(height);
+    mno::tile_scheduler scheduler{};
+    for (auto const level : simd_levels()) {
+        for (auto const& start : mandelbrot_views) {
+            mno::image image{width, height, mno::pixel_format::r32f};
+            mandelbrot reused{start, level};
+            reused.render(image, scheduler);
+
+            auto view = start;
+            for (std::int32_t step = 0; step < 10; step++) {
+                auto const pixel = view.scale / width;
+                auto expected = pixels;
+                if (step < 6) {
+                    view.center_x += mno::f64(width / 8) * pixel;
+                    expected = std::size_t(width / 8) * std::size_t(height);
+                } else if (step % 2 == 0) {
+                    view.scale *= 0.5;
+                    expected = pixels - pixels / 4;
+                } else {
+                    view.scale *= 2.0;
+                    expected = pixels - pixels / 4;
+                }
+                auto const missing = reused.reproject(view, image);
+                check(missing == expected, std::to_string(missing) + " pixels missing after step " +
+                      std::to_string(step) + " at " + describe(start, level));
+                if (step % 2 == 0) {
+                    scheduler.run(image, [&](mno::tile const& tile) {
+                        reused.render_missing(image, tile.x0, tile.y0, tile.x1, tile.y1);
+                    });
+                } else {
+                    progressive passes{};
+                    while (!passes.is_done()) {
+                        passes.run(width, height, scheduler, 1e9, [&](interlace_pass const& pass, mno::tile const& tile) {
+                            reused.render(image, pass, tile.x0, tile.y0, tile.x1, tile.y1);
+                        });
+                    }
+                }
+
+                mno::image full{width, height, mno::pixel_format::r32f};
+                mandelbrot single{view, level};
+                single.render(full, scheduler);
+                auto const count = mismatches(single.iterations(), reused.iterations());
+                check(count == 0, std::to_string(count) + " pixels differ after step " + std::to_string(step) +
+                      " at " + describe(start, level));
+                for (std::int32_t y = 0; y < height; y++) {
+                    auto const a = full.row<mno::f32>(y);
+                    auto const b = image.row<mno::f32>(y);
+                    check(std::equal(std::begin(a), std::end(a), std::begin(b)),
+                          "image row " + std::to_string(y) + " differs after step " + std::to_string(step));
+                }
+            }
+        }
+    }
+
+    // An image of the same area but another shape reuses nothing
+    for (auto const& view : mandelbrot_views) {
+        mno::image wide{200, 100, mno::pixel_format::r32f};
+        mandelbrot reused{view, mno::simd_level::scalar};
+        reused.render(wide, scheduler);
+        mno::image tall{100, 200, mno::pixel_format::r32f};
+        auto const missing = reused.reproject(view, tall);
+        check(missing == 20000, std::to_string(missing) + " pixels missing after a reshape at " +
+              describe(view, mno::simd_level::scalar));
+        scheduler.run(tall, [&](mno::tile const& tile) {
+            reused.render_missing(tall, tile.x0, tile.y0, tile.x1, tile.y1);
+        });
+        mandelbrot single{view, mno::simd_level::scalar};
+        single.render(tall, scheduler);
+        auto const count = mismatches(single.iterations(), reused.iterations());
+        check(count == 0, std::to_string(count) + " pixels differ after a reshape at " +
+              describe(view, mno::simd_level::scalar));
+    }
+}
+
+// Tiles reach the disk through the writer, the directory stays within its
+// budget and only rendered tiles are stored again after a load.
+static auto test_tile_cache() -> void {
+    auto const directory = std::filesystem::temp_directory_path() / "fractals_tests_tiles";
+    std::filesystem::remove_all(directory);
+    constexpr std::int32_t width  = 256;
+    constexpr std::int32_t height = 128;
+    constexpr std::int32_t tile   = 64;
+    // Room for three tiles on disk
+    auto const tile_bytes = 80 + std::size_t(tile) * std::size_t(tile) * sizeof(mno::f32);
+    {
+        tile_cache cache{directory, tile_cache::default_memory_bytes, tile_bytes * 3};
+        mno::image image{width, height, mno::pixel_format::r32f};
+        mandelbrot renderer{};
+        renderer.render(image);
+        for (std::int32_t x = 0; x < width; x += tile)
+            check(renderer.store(image, cache, x, 0, x + tile, tile), "rendered tile not stored");
+        cache.flush();
+        check(cache.disk_bytes() == tile_bytes * 3, "disk budget exceeded: " + cache.str());
+
+        mandelbrot loaded{};
+        loaded.prepare(image);
+        check(loaded.load(image, cache, width - tile, 0, width, tile), "stored tile not loaded");
+        check(!loaded.store(image, cache, width - tile, 0, width, tile), "loaded tile stored again");
+    }
+    std::size_t files = 0;
+    for (auto const& item : std::filesystem::directory_iterator{directory}) files += item.path().extension() == ".tile";
+    check(files == 3, std::to_string(files) + " files on disk, expected 3");
+
+    // A new cache finds the most recent tiles on disk and drops the
+    // temporary of a write that was cut short
+    auto const leftover = directory / "0123456789abcdef.tile.tmp";
+    std::ofstream{leftover} << "partial";
+    tile_cache cache{directory, tile_cache::default_memory_bytes, tile_bytes * 3};
+    check(!std::filesystem::exists(leftover), "interrupted write left behind");
+    mno::image image{width, height, mno::pixel_format::r32f};
+    mandelbrot renderer{};
+    renderer.prepare(image);
+    check(renderer.load(image, cache, width - tile, 0, width, tile), "tile lost across restarts");
+    check(!renderer.load(image, cache, 0, 0, tile, tile), "least recently used tile kept");
+
+    // Forcing another precision than the view resolves to changes the counts
+    renderer.set_precision(mandelbrot::precision::f64);
+    check(!(renderer.cache_key(image, 0, 0, tile, tile) == mandelbrot{}.cache_key(image, 0, 0, tile, tile)),
+          "f64 counts share a key with f32 ones");
+    std::filesystem::remove_all(directory);
+}
+
+// Reference centres are kept as decimal strings, printing and parsing one
+// must give back the same number at every precision, including values
+// whose low limbs are full from arithmetic.
+static auto test_bignum_round_trip() -> void {
+    for (std::size_t const limbs : {2, 3, 5, 9}) {
+        std::vector<bignum> values{};
+        for (auto const x : {0.0, 0.1, -0.743643887037151, 0.131825904205330, 1.0 / 3.0, -1.9999999999999998})
+            values.emplace_back(x, limbs);
+        auto const count = values.size();
+        for (std::size_t i = 0; i < count; i++) {
+            values.push_back(values[i] * values[(i + 1) % count] + values[(i + 2) % count]);
+            values.push_back(values.back() * values.back() - values[i]);
+        }
+        values.emplace_back("0.123456789012345678901234567890123456789012345678901234567890", limbs);
+        for (auto const& value : values) {
+            auto const printed = value.str();
+            auto const parsed  = bignum{printed, limbs};
+            check((parsed - value).is_zero(), printed + " parsed back to " + parsed.str() + " with " +
+                  std::to_string(limbs) + " limbs");
+            check(parsed.str() == printed, printed + " printed again as " + parsed.str());
+        }
+    }
+    // The last digit rounds, 2^-32 = 0.00000000023283064365...
+    check(bignum{"0.00000000023283064365", 2}.str() == "0.0000000002", "2^-32 not rounded down");
+    check(bignum{"0.99999999976716935634", 2}.str() == "0.9999999998", "1 - 2^-32 not rounded up");
+
+    // Mixed precisions and results past 2^32 throw instead of reading past
+    // the limbs or wrapping
+    auto const throws = [](auto const& fn) {
+        try {
+            fn();
+        } catch (std::exception const&) {
+            return true;
+        }
+        return false;
+    };
+    check(throws([] { return bignum{0.1, 3} + bignum{0.1, 2}; }), "mixed limbs added");
+    check(throws([] { return bignum{0.1, 2} * bignum{0.1, 3}; }), "mixed limbs multiplied");
+    check(throws([] { return bignum{4294967295.0, 2} + bignum{1.0, 2}; }), "sum wrapped");
+    check(throws([] { return bignum{65536.0, 2} * bignum{65536.0, 2}; }), "product wrapped");
+    check((bignum{65535.0, 2} * bignum{65537.0, 2}).to_f64() == 4294967295.0, "largest product lost");
+}
+
+// The viewer hands views between the f64 kernels and perturbation, the
+// centre must survive the trip and pans past f64 precision must still move.
+static auto test_deep_zoom_handoff() -> void {
+    mandelbrot_view const view{-0.743643887037151, 0.131825904205330, 2e-10, 256};
+    auto const deep = deep_zoom_view_of(view);
+    auto const back = mandelbrot_view_of(deep);
+    check(back.center_x == view.center_x && back.center_y == view.center_y, "centre changed on the way back");
+    check(!mandelbrot::is_deep(view, 640), "2e-10 handed over too early");
+    check(mandelbrot::is_deep({view.center_x, view.center_y, 1e-11, 256}, 640), "1e-11 not handed over");
+
+    auto deeper = deep;
+    deeper.scale = 1e-30;
+    auto const moved = pan(deeper, 1e-31, -1e-31);
+    check(moved.center_x != deeper.center_x && moved.center_y != deeper.center_y, "pan lost at 1e-30");
+    auto const restored = pan(moved, -1e-31, 1e-31);
+    check(mandelbrot_view_of(restored).center_x == view.center_x, "pan there and back moved the centre");
+}
+
+// Escape counts of a deep view iterated directly in long double with the
+// same pixel centres as perturbation. Long double only holds up to about
+// 1e-8 at a thousand iterations, deeper views need the reference orbit.
+static auto deep_zoom_reference(deep_zoom_view const& view, std::int32_t const& width,
+                                std::int32_t const& height) -> std::vector<std::uint32_t> {
+    using real = long double;
+    auto const center_x = std::strtold(view.center_x.c_str(), nullptr);
+    auto const center_y = std::strtold(view.center_y.c_str(), nullptr);
+    auto const pixel    = real(view.scale) / width;
+    std::vector<std::uint32_t> counts(std::size_t(width) * std::size_t(height));
+    for (std::int32_t y = 0; y < height; y++) {
+        auto const ci = center_y + (y + 0.5L - height * 0.5L) * pixel;
+        for (std::int32_t x = 0; x < width; x++) {
+            auto const cr = center_x + (x + 0.5L - width * 0.5L) * pixel;
+            real zr = 0.0L, zi = 0.0L;
+            std::uint32_t n = 0;
+            while (n < view.max_iterations) {
+                auto const t = zr * zr - zi * zi + cr;
+                zi = 2.0L * zr * zi + ci;
+                zr = t;
+                if (!(zr * zr + zi * zi < 4.0L)) break;
+                n++;
+            }
+            counts[std::size_t(y) * std::size_t(width) + std::size_t(x)] = n;
+        }
+    }
+    return counts;
+}
+
+// Perturbation without the series agrees with direct iteration up to a few
+// boundary pixels where either side rounds differently.
+static auto test_perturbation_matches_reference() -> void {
+    constexpr std::int32_t width  = 320;
+    constexpr std::int32_t height = 240;
+    constexpr auto budget = std::size_t(width) * std::size_t(height) / 1000;
+    std::vector<deep_zoom_view> const views{
+        {"-0.5", "0.0", 3.0, 1024},
+        {"-0.743643887037158704752191506114774", "0.131825904205311970493132056385139", 1e-8, 1024},
+    };
+    mno::tile_scheduler scheduler{};
+    for (auto const& view : views) {
+        mno::image image{width, height, mno::pixel_format::r32f};
+        perturbation deep{view};
+        deep.set_series_approximation(false);
+        deep.render(image, scheduler);
+        auto const count = mismatches(deep_zoom_reference(view, width, height), deep.iterations());
+        char scale[32];
+        std::snprintf(scale, sizeof(scale), "%g", view.scale);
+        check(count <= budget, std::to_string(count) + " pixels differ from long double at scale " + scale);
+    }
+
+    // The reference at -0.5 passes close to zero, pixels around it glitch.
+    // Running off the end of the reference rebases a pixel at most once, so
+    // more rebases than pixels means glitches were caught.
+    mno::image image{width, height, mno::pixel_format::r32f};
+    perturbation glitchy{views.front()};
+    glitchy.set_series_approximation(false);
+    glitchy.render(image, scheduler);
+    check(glitchy.rebases() > std::uint64_t(width) * std::uint64_t(height),
+          "only " + std::to_string(glitchy.rebases()) + " rebases at -0.5");
+}
+
+// The series must skip iterations on deep views without changing a single
+// count, a wrong coefficient or probe check shows up as a mismatch here.
+static auto test_series_approximation() -> void {
+    constexpr std::int32_t width  = 320;
+    constexpr std::int32_t height = 240;
+    std::vector<deep_zoom_view> const views{
+        {"-0.743643887037158704752191506114774", "0.131825904205311970493132056385139", 1e-14, 4096},
+        {"-0.743643887037158704752191506114774", "0.131825904205311970493132056385139", 1e-25, 8192},
+    };
+    mno::tile_scheduler scheduler{};
+    for (auto const& view : views) {
+        char scale[32];
+        std::snprintf(scale, sizeof(scale), "%g", view.scale);
+        mno::image image{width, height, mno::pixel_format::r32f};
+        perturbation series{view};
+        series.set_series_approximation(true);
+        series.render(image, scheduler);
+        check(series.skipped() > 0, std::string("nothing skipped at scale ") + scale);
+
+        perturbation full{view};
+        full.set_series_approximation(false);
+        full.render(image, scheduler);
+        check(full.skipped() == 0, std::string("skipped with the series off at scale ") + scale);
+        auto const count = mismatches(full.iterations(), series.iterations());
+        check(count == 0, std::to_string(count) + " pixels differ with " + std::to_string(series.skipped()) +
+              " iterations skipped at scale " + scale);
+    }
+}
+
+// Dead cells outside the board, one byte per cell.
+static auto life_reference(std::vector<std::uint8_t> const& cells, std::int32_t const& width,
+                           std::int32_t const& height) -> std::vector<std::uint8_t> {
+    std::vector<std::uint8_t> next(cells.size(), 0);
+    for (std::int32_t y = 0; y < height; y++) {
+        for (std::int32_t x = 0; x < width; x++) {
+            std::int32_t neighbours = 0;
+            for (std::int32_t dy = -1; dy <= 1; dy++) {
+                for (std::int32_t dx = -1; dx <= 1; dx++) {
+                    auto const nx = x + dx, ny = y + dy;
+                    if ((dx != 0 || dy != 0) && nx >= 0 && nx < width && ny >= 0 && ny < height)
+                        neighbours += cells[std::size_t(ny) * std::size_t(width) + std::size_t(nx)];
+                }
+            }
+            auto const i = std::size_t(y) * std::size_t(width) + std::size_t(x);
+            next[i] = neighbours == 3 || (neighbours == 2 && cells[i] != 0);
+        }
+    }
+    return next;
+}
+
+static auto life_cells(life const& board) -> std::vector<std::uint8_t> {
+    std::vector<std::uint8_t> cells(std::size_t(board.width()) * std::size_t(board.height()));
+    for (std::int32_t y = 0; y < board.height(); y++)
+        for (std::int32_t x = 0; x < board.width(); x++)
+            cells[std::size_t(y) * std::size_t(board.width()) + std::size_t(x)] = board.get(x, y);
+    return cells;
+}
+
+// Steps the board next to the brute-force reference and compares every
+// generation, alternating between the single and multi-threaded step.
+static auto check_life(life& board, std::int32_t const& generations, mno::tile_scheduler& scheduler,
+                       std::string const& name) -> std::size_t {
+    auto expected = life_cells(board);
+    std::size_t min_active = ~std::size_t(0);
+    for (std::int32_t generation = 1; generation <= generations; generation++) {
+        if (generation % 2 == 0) board.step(scheduler);
+        else board.step();
+        expected = life_reference(expected, board.width(), board.height());
+        min_active = std::min(min_active, board.active_tiles());
+        auto const actual = life_cells(board);
+        std::size_t count = 0;
+        for (std::size_t i = 0; i < actual.size(); i++) count += actual[i] != expected[i];
+        check(count == 0, std::to_string(count) + " cells differ at generation " + std::to_string(generation) +
+              " of " + name + " on " + mno::to_string(board.simd_level()));
+    }
+    return min_active;
+}
+
+// The width leaves a partial last word so tail masking is exercised, and
+// the sparse board's gliders leave tiles to go quiet and wake up others,
+// one of them running into the right edge.
+static auto test_life_matches_reference() -> void {
+    constexpr std::int32_t width  = 1500;
+    constexpr std::int32_t height = 512;
+    constexpr auto tiles = std::size_t((width + life::tile_words * 64 - 1) / (life::tile_words * 64)) *
+                           std::size_t(height / life::tile_rows);
+    mno::tile_scheduler scheduler{};
+    for (auto const level : simd_levels()) {
+        life dense{width, height, level};
+        dense.randomize(7, 0.4f);
+        check_life(dense, 48, scheduler, "a random board");
+
+        life sparse{width, height, level};
+        auto const glider = [&](std::int32_t const& x, std::int32_t const& y) {
+            std::int32_t const cells[][2]{{1, 0}, {2, 1}, {0, 2}, {1, 2}, {2, 2}};
+            for (auto const& cell : cells) sparse.set(x + cell[0], y + cell[1], true);
+        };
+        glider(40, 40);
+        glider(width - 30, 300);
+        // A block is still from the start and a blinker never settles
+        for (auto const& cell : {std::array{900, 250}, std::array{901, 250}, std::array{900, 251}, std::array{901, 251}})
+            sparse.set(cell[0], cell[1], true);
+        for (std::int32_t x = 300; x < 303; x++) sparse.set(x, 460, true);
+        auto const min_active = check_life(sparse, 160, scheduler, "gliders");
+        check(min_active < tiles, "quiet tiles were still stepped");
+    }
+}
+
+// Acorn at the centre of a board big enough that nothing reaches its edges,
+// HashLife jumps 2^k generations at a time and the bit-packed board steps
+// one by one. A low collection threshold makes steps run collect() between
+// them, cached successors have to survive the remap.
+static auto test_hashlife_matches_life() -> void {
+    constexpr std::int32_t size   = 1024;
+    constexpr std::int32_t centre = size / 2;
+    hashlife universe{};
+    universe.set_gc_threshold(1024);
+    life board{size, size};
+    std::int32_t const acorn[][2]{{1, 0}, {3, 1}, {0, 2}, {1, 2}, {4, 2}, {5, 2}, {6, 2}};
+    for (auto const& cell : acorn) {
+        universe.set(cell[0], cell[1], true);
+        board.set(centre + cell[0], centre + cell[1], true);
+    }
+
+    std::size_t collections = 0;
+    for (auto const log2_generations : {0u, 1u, 3u, 2u, 5u, 0u, 4u, 6u, 1u, 7u, 3u}) {
+        auto const nodes = universe.nodes();
+        universe.step(log2_generations);
+        collections += universe.nodes() < nodes;
+        for (std::uint32_t i = 0; i < (1u << log2_generations); i++) board.step();
+        if (log2_generations % 2 == 1) {
+            universe.collect();
+            collections++;
+        }
+
+        auto const generation = std::to_string(universe.generation());
+        check(universe.generation() == board.generation(), "generation " + generation + " out of step");
+        check(universe.population() == board.population(), "population differs at generation " + generation);
+        std::size_t count = 0;
+        for (std::int32_t y = 0; y < size; y++)
+            for (std::int32_t x = 0; x < size; x++)
+                count += universe.get(x - centre, y - centre) != board.get(x, y);
+        check(count == 0, std::to_string(count) + " cells differ at generation " + generation);
+    }
+    check(collections > 6, "the node store was never collected during a step");
+}
+
+// Known-answer vectors of Philox4x32-10 from the Random123 distribution,
+// then the AVX2 stream against the scalar one over unaligned ranges and the
+// carry into the counter's high word. Seeds must give the same boards on
+// every machine.
+static auto test_philox() -> void {
+    struct vector {
+        std::array<std::uint32_t, 4> counter;
+        std::array<std::uint32_t, 2> key;
+        std::array<std::uint32_t, 4> expected;
+    };
+    vector const vectors[]{
+        {{0x00000000, 0x00000000, 0x00000000, 0x00000000}, {0x00000000, 0x00000000},
+         {0x6627E8D5, 0xE169C58D, 0xBC57AC4C, 0x9B00DBD8}},
+        {{0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF}, {0xFFFFFFFF, 0xFFFFFFFF},
+         {0x408F276D, 0x41C83B0E, 0xA20BC7C6, 0x6D5451FD}},
+        {{0x243F6A88, 0x85A308D3, 0x13198A2E, 0x03707344}, {0xA4093822, 0x299F31D0},
+         {0xD16CFE09, 0x94FDCCEB, 0x5001E420, 0x24126EA1}},
+    };
+    for (auto const& v : vectors)
+        check(mno::philox(v.counter, v.key) == v.expected, "known-answer vector mismatch");
+    check(mno::philox(0, 0) == vectors[0].expected, "seeded form differs from the full generator");
+
+    auto const scalar = mno::random_kernel_for(mno::simd_level::scalar);
+    for (auto const level : simd_levels()) {
+        auto const kernel = mno::random_kernel_for(level);
+        struct range {
+            std::uint64_t first;
+            std::size_t   count;
+        };
+        range const ranges[]{{0, 1000}, {1, 31}, {3, 97}, {4 * 0xFFFFFFF8ull + 2, 100}, {(1ull << 40) + 5, 333}};
+        for (auto const& r : ranges) {
+            std::vector<std::uint32_t> expected(r.count), actual(r.count);
+            scalar(0x123456789ABCDEF0ull, r.first, expected.data(), r.count);
+            kernel(0x123456789ABCDEF0ull, r.first, actual.data(), r.count);
+            check(expected == actual, "stream at " + std::to_string(r.first) + " differs on " + mno::to_string(level));
+        }
+    }
+}
+
+// Set bits of random_bits stay within five standard deviations of the
+// density, and a board filled in two calls equals one filled at once.
+static auto test_random_bits() -> void {
+    constexpr std::size_t words = 1 << 14;
+    std::vector<std::uint64_t> bits(words);
+    for (auto const density : {0.0f, 0.02f, 0.25f, 0.5f, 0.7f, 0.9f, 1.0f}) {
+        mno::random_bits(42, 0, bits.data(), words, density);
+        std::uint64_t count = 0;
+        for (auto const word : bits) count += std::uint64_t(std::popcount(word));
+        auto const n = mno::f64(words * 64);
+        auto const p = mno::f64(density);
+        auto const tolerance = 5.0 * std::sqrt(n * p * (1.0 - p));
+        check(std::abs(mno::f64(count) - n * p) <= tolerance,
+              std::to_string(count) + " of " + std::to_string(words * 64) + " bits set at density " +
+              std::to_string(density));
+
+        std::vector<std::uint64_t> split(words);
+        mno::random_bits(42, 0, split.data(), 1000, density);
+        mno::random_bits(42, 1000, split.data() + 1000, words - 1000, density);
+        check(split == bits, "split fill differs at density " + std::to_string(density));
+    }
+}
+}  // namespace nrv
+
+auto main() -> std::int32_t {
+    std::vector<nrv::test_case> const tests{
+        {"kernels agree",              nrv::test_kernels_agree},
+        {"progressive matches render", nrv::test_progressive_matches_render},
+        {"reproject matches render",   nrv::test_reproject_matches_render},
+        {"tile cache",                 nrv::test_tile_cache},
+        {"bignum round trip",          nrv::test_bignum_round_trip},
+        {"deep zoom handoff",          nrv::test_deep_zoom_handoff},
+        {"perturbation matches reference", nrv::test_perturbation_matches_reference},
+        {"series approximation",       nrv::test_series_approximation},
+        {"life matches reference",     nrv::test_life_matches_reference},
+        {"hashlife matches life",      nrv::test_hashlife_matches_life},
+        {"philox",                     nrv::test_philox},
+        {"random bits",                nrv::test_random_bits},
+    };
+    std::int32_t failed = 0;
+    for (auto const& test : tests) {
+        try {
+            test.fn();
+            std::printf("PASS %s\n", test.name.c_str());
+        } catch (std::exception const& error) {
+            std::printf("FAIL %s: %s\n", test.name.c_str(), error.what());
+            failed++;
+        }
+    }
+    return failed == 0 ? 0 : 1;
+}
@@ -163,6 +163,34 @@ class renderbuffer {
     std::uint32_t m_buffer{};
 };
 
+// Uniform block storage shared between programs. Every program that declares
+// the block is pointed at the same binding point with shader::bind_block().
+class uniform_buffer {
+  public:
+    uniform_buffer(std::uint32_t const& size, std::uint32_t const& binding);
+    ~uniform_buffer() noexcept;
+
+    auto bind() const -> void;
+    auto unbind() const -> void;
+
+    // Replace the block contents, the previous storage is orphaned so the
+    // upload never waits on draws that still read last frame's values.
+    auto update(void const* data, std::uint32_t const& size) -> void;
+    template <typename T>
+    auto update(T const& value) -> void { update(&value, sizeof(T)); }
+
+    auto size() const -> std::uint32_t { return m_size; }
+    auto binding() const -> std::uint32_t { return m_binding; }
+
+  public:
+    static auto make(std::uint32_t const& size, std::uint32_t const& binding) -> local<uniform_buffer>;
+
+  private:
+    std::uint32_t m_buffer{};
+    std::uint32_t m_size;
+    std::uint32_t m_binding;
+};
+
 class array_buffer {
   public:
     array_buffer();
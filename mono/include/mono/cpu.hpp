@@ -0,0 +1,31 @@
+/**
+ * @file   cpu.hpp
+ * @author Pratchaya Khansomboon (me@mononerv.dev)
+ * @brief  Host CPU feature queries.
+ * @date   2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ */
+#ifndef MONO_CPU_HPP
+#define MONO_CPU_HPP
+
+#include <cstdint>
+#include <string>
+
+#include "common.hpp"
+
+namespace mno {
+// Widest SIMD instruction set usable on this machine, ordered so that
+// comparisons like `level >= simd_level::sse2` work.
+enum class simd_level : std::uint32_t {
+    scalar = 0,
+    sse2,
+    avx2,
+};
+
+// Detected once and cached, safe to call from any thread.
+[[nodiscard]] auto cpu_simd_level() -> simd_level;
+[[nodiscard]] auto to_string(simd_level const& level) -> std::string;
+}  // namespace mno
+
+#endif // MONO_CPU_HPP
@@ -0,0 +1,60 @@
+/**
+ * @file   double_buffered_target.hpp
+ * @author Pratchaya Khansomboon (me@mononerv.dev)
+ * @brief  Ping-pong framebuffer pair for iterative GPU simulations.
+ * @date   2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ */
+#ifndef MONO_DOUBLE_BUFFERED_TARGET_HPP
+#define MONO_DOUBLE_BUFFERED_TARGET_HPP
+
+#include <cstdint>
+#include <functional>
+#include <string>
+
+#include "common.hpp"
+#include "texture.hpp"
+#include "framebuffer.hpp"
+
+namespace mno {
+// Two colour only framebuffers of the same size. A pass reads the front
+// texture, the previous generation, and renders into the back target, swap()
+// then flips the roles without touching any storage.
+class double_buffered_target {
+  public:
+    double_buffered_target(std::int32_t const& width, std::int32_t const& height,
+                           texture_format const& format = texture_format::r8);
+    ~double_buffered_target() = default;
+
+    auto width() const -> std::int32_t { return m_front->width(); }
+    auto height() const -> std::int32_t { return m_front->height(); }
+    auto format() const -> texture_format { return m_format; }
+
+    // Latest generation, sample this one.
+    auto front() -> framebuffer& { return *m_front; }
+    // Render target of the next generation.
+    auto back() -> framebuffer& { return *m_back; }
+    auto texture() -> ref<mno::texture> { return m_front->texture(); }
+
+    auto swap() -> void;
+    // Reallocates both attachments, the contents are undefined afterwards.
+    auto resize(std::int32_t const& width, std::int32_t const& height) -> void;
+
+    // Runs pass generations times entirely on the GPU. Before every call the
+    // back target is bound with a viewport covering it and the front texture
+    // is bound to texture unit, the roles swap after each call. The default
+    // framebuffer is bound again at the end, the viewport is left as is.
+    auto run(std::int32_t const& generations, std::uint32_t const& unit,
+             std::function<void()> const& pass) -> void;
+
+    [[nodiscard]] auto str() const -> std::string;
+
+  private:
+    texture_format    m_format;
+    local<framebuffer> m_front;
+    local<framebuffer> m_back;
+};
+}  // namespace mno
+
+#endif // MONO_DOUBLE_BUFFERED_TARGET_HPP
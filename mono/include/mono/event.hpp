@@ -13,6 +13,7 @@
 #include <string>
 #include <vector>
 #include <type_traits>
+#include <variant>
 
 #include "common.hpp"
 #include "keyboard.hpp"
@@ -43,6 +44,7 @@ enum class event_type : std::uint32_t {
     // keyboard
     key_down, key_up, key_typed,
 };
+inline constexpr std::size_t event_type_count = std::size_t(event_type::key_typed) + 1;
 
 class event {
   public:
@@ -114,7 +116,7 @@ class update_event : public event {
 class draw_event : public event {
   public:
     draw_event(mno::f64 const& time, mno::f64 const& delta)
-        : event(event_type::update, event_category::application),
+        : event(event_type::draw, event_category::application),
           m_time(time), m_delta(delta) {}
 
     auto name() const -> std::string override { return "draw_event"; }
@@ -546,6 +548,15 @@ class key_typed_event : public event {
     std::uint32_t m_code_point;
 };
 
+// Any concrete event by value, the element type of the window's event queue.
+using event_variant = std::variant<
+    std::monostate,
+    drop_event, update_event, draw_event,
+    window_resize_event, window_move_event, window_focus_event, window_icon_event,
+    window_maximize_event, buffer_resize_event, content_scale_event,
+    mouse_enter_event, mouse_leave_event, mouse_move_event, mouse_press_event,
+    mouse_release_event, mouse_wheel_event,
+    key_down_event, key_up_event, key_typed_event>;
 }  // namespace mno
 
 #endif // MONO_EVENT_HPP
@@ -13,12 +13,15 @@
 #include "common.hpp"
 #include "buffer.hpp"
 #include "texture.hpp"
+#include "image.hpp"
 
 namespace mno {
 class framebuffer {
   public:
     framebuffer(std::int32_t const& width, std::int32_t const& height);
     framebuffer(ref<mno::texture> const& texture, ref<mno::renderbuffer> const& render);
+    // Colour only target without a depth-stencil attachment.
+    explicit framebuffer(ref<mno::texture> const& texture);
     ~framebuffer() noexcept;
 
     auto bind() const -> void;
@@ -29,6 +32,9 @@ class framebuffer {
     auto resize(std::int32_t const& width, std::int32_t const& height) -> void;
     auto texture() -> ref<mno::texture> { return m_texture; }
 
+    // Blocking RGBA8 readback of the colour attachment, rows bottom to top.
+    auto read(mno::image& image) const -> void;
+
   private:
     std::uint32_t           m_buffer{};
     ref<mno::texture>      m_texture{nullptr};
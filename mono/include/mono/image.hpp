@@ -10,32 +10,197 @@
 #define MONO_IMAGE_HPP
 
 #include "common.hpp"
+#include <cstddef>
 #include <cstdint>
+#include <memory_resource>
+#include <span>
+#include <string>
 
 namespace mno {
+// Channel layout and type of the pixels. 8-bit and 16-bit channels are
+// unsigned normalised, f32 channels are stored as is.
+enum class pixel_format : std::uint32_t {
+    r8 = 0,
+    rg8,
+    rgb8,
+    rgba8,
+    r16,
+    rgba16,
+    r32f,
+    rgba32f,
+};
+
+[[nodiscard]] auto channel_count(pixel_format const& format) -> std::int32_t;
+[[nodiscard]] auto channel_size(pixel_format const& format) -> std::size_t;
+[[nodiscard]] auto pixel_size(pixel_format const& format) -> std::size_t;
+// 8-bit format with the given number of channels, 1 to 4.
+[[nodiscard]] auto pixel_format_of(std::int32_t const& channels) -> pixel_format;
+[[nodiscard]] auto to_string(pixel_format const& format) -> std::string;
+
+// Non-owning 2D view of an image's channels with the layout of a strided
+// std::mdspan, (x, y) is the first channel of a pixel and row(y) the
+// contiguous channels of one row. T is the channel type of the format.
+template <typename T>
+class image_view {
+  public:
+    image_view() = default;
+    image_view(T* data, std::int32_t const& width, std::int32_t const& height,
+               std::int32_t const& channels, std::size_t const& stride)
+        : m_data(data), m_width(width), m_height(height), m_channels(channels), m_stride(stride) {}
+
+    auto width() const -> std::int32_t { return m_width; }
+    auto height() const -> std::int32_t { return m_height; }
+    auto channels() const -> std::int32_t { return m_channels; }
+    // Channels from one row to the next.
+    auto stride() const -> std::size_t { return m_stride; }
+    auto data() const -> T* { return m_data; }
+
+    auto operator()(std::int32_t const& x, std::int32_t const& y) const -> T* {
+        return m_data + std::size_t(y) * m_stride + std::size_t(x) * std::size_t(m_channels);
+    }
+    auto row(std::int32_t const& y) const -> std::span<T> {
+        return {m_data + std::size_t(y) * m_stride, std::size_t(m_width) * std::size_t(m_channels)};
+    }
+    // View of the rectangle [x0, x1) x [y0, y1), sharing the storage.
+    auto subview(std::int32_t const& x0, std::int32_t const& y0,
+                 std::int32_t const& x1, std::int32_t const& y1) const -> image_view {
+        return {(*this)(x0, y0), x1 - x0, y1 - y0, m_channels, m_stride};
+    }
+
+  private:
+    T*           m_data{nullptr};
+    std::int32_t m_width{0};
+    std::int32_t m_height{0};
+    std::int32_t m_channels{0};
+    std::size_t  m_stride{0};
+};
+
+// Pixels live in one block aligned to image::alignment bytes, rows are
+// stride() bytes apart and start on a multiple of row_alignment bytes.
+// Storage comes from a std::pmr::memory_resource so batches of frames can
+// share an arena. Resizing to the same or a smaller size reuses the block.
+//
+// Copies allocate from the default resource like std::pmr containers and
+// copy assignment keeps the resource of the target. Moves, constructor and
+// assignment alike, never allocate and take the resource with them.
 class image {
   public:
-    image(std::int32_t const& width, std::int32_t const& height, std::int32_t const& channels = 4);
+    static constexpr std::size_t alignment = 64;
+
+  public:
+    image();
+    image(std::int32_t const& width, std::int32_t const& height, std::int32_t const& channels = 4,
+          std::size_t const& row_alignment = 1,
+          std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+    image(std::int32_t const& width, std::int32_t const& height, pixel_format const& format,
+          std::size_t const& row_alignment = 1,
+          std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+    image(image const& other);
+    image(image&& other) noexcept;
     ~image();
 
+    auto operator=(image const& other) -> image&;
+    auto operator=(image&& other) noexcept -> image&;
+
+    // Contents are undefined after a resize.
     auto resize(std::int32_t const& width, std::int32_t const& height, std::int32_t const& channels = 4) -> void;
+    auto resize(std::int32_t const& width, std::int32_t const& height, pixel_format const& format) -> void;
 
     auto width() const -> std::int32_t { return m_width; }
     auto height() const -> std::int32_t { return m_height; }
     auto channels() const -> std::int32_t { return m_channels; }
+    auto format() const -> pixel_format { return m_format; }
+    auto pixel_size() const -> std::size_t { return mno::pixel_size(m_format); }
+    // Bytes from one row to the next, always a multiple of pixel_size().
+    auto stride() const -> std::size_t { return m_stride; }
+    auto size() const -> std::size_t { return m_stride * std::size_t(m_height); }
+    auto capacity() const -> std::size_t { return m_capacity; }
+    auto row_alignment() const -> std::size_t { return m_row_alignment; }
+    auto resource() const -> std::pmr::memory_resource* { return m_resource; }
+
+    // 0xRRGGBB colour access for any format, channels the format lacks are
+    // dropped on set and read as 0 on get, values convert to and from 8 bits.
     auto get(std::int32_t const& x, std::int32_t const& y) const -> std::uint32_t;
     auto set(std::int32_t const& x, std::int32_t const& y, std::uint32_t const& color, std::uint8_t const& alpha = 255) -> void;
     auto set(std::int32_t const& x, std::int32_t const& y,
              std::uint8_t const& red,  std::uint8_t const& green,
              std::uint8_t const& blue, std::uint8_t const& alpha = 255) -> void;
 
+    // Typed access to the channels of a pixel, T must match the channel type
+    // of the format: std::uint8_t, std::uint16_t or mno::f32.
+    template <typename T>
+    auto pixel(std::int32_t const& x, std::int32_t const& y) -> T* {
+        return reinterpret_cast<T*>(m_buffer + std::size_t(y) * m_stride + std::size_t(x) * pixel_size());
+    }
+    template <typename T>
+    auto pixel(std::int32_t const& x, std::int32_t const& y) const -> T const* {
+        return reinterpret_cast<T const*>(m_buffer + std::size_t(y) * m_stride + std::size_t(x) * pixel_size());
+    }
+
+    // Channels of row y, or of pixels [x0, x1) in row y. Loops over a span
+    // run without per-pixel index math and vectorize.
+    template <typename T>
+    auto row(std::int32_t const& y) -> std::span<T> {
+        return view<T>().row(y);
+    }
+    template <typename T>
+    auto row(std::int32_t const& y) const -> std::span<T const> {
+        return view<T>().row(y);
+    }
+    template <typename T>
+    auto row(std::int32_t const& y, std::int32_t const& x0, std::int32_t const& x1) -> std::span<T> {
+        return row<T>(y).subspan(std::size_t(x0) * std::size_t(m_channels),
+                                 std::size_t(x1 - x0) * std::size_t(m_channels));
+    }
+    template <typename T>
+    auto row(std::int32_t const& y, std::int32_t const& x0, std::int32_t const& x1) const -> std::span<T const> {
+        return row<T>(y).subspan(std::size_t(x0) * std::size_t(m_channels),
+                                 std::size_t(x1 - x0) * std::size_t(m_channels));
+    }
+
+    template <typename T>
+    auto view() -> image_view<T> {
+        return {reinterpret_cast<T*>(m_buffer), m_width, m_height, m_channels, m_stride / sizeof(T)};
+    }
+    template <typename T>
+    auto view() const -> image_view<T const> {
+        return {reinterpret_cast<T const*>(m_buffer), m_width, m_height, m_channels, m_stride / sizeof(T)};
+    }
+
+    // Set every pixel, or the pixels of [x0, x1) x [y0, y1), to one colour.
+    // The pixel is converted once and then copied row by row.
+    auto fill(std::uint32_t const& color, std::uint8_t const& alpha = 255) -> void;
+    auto fill(std::int32_t const& x0, std::int32_t const& y0, std::int32_t const& x1, std::int32_t const& y1,
+              std::uint32_t const& color, std::uint8_t const& alpha = 255) -> void;
+
+    // Replace every channel value v with fn(v), T is the channel type.
+    template <typename T, typename Fn>
+    auto transform(Fn&& fn) -> void {
+        for (std::int32_t y = 0; y < m_height; y++)
+            for (auto& value : row<T>(y)) value = fn(value);
+    }
+
     auto buffer() const -> std::uint8_t* { return m_buffer; }
+
   private:
-    std::uint8_t* m_buffer;
+    // Sets the size and recomputes the stride, growing the block if needed.
+    auto reshape(std::int32_t const& width, std::int32_t const& height, pixel_format const& format) -> void;
+    auto compute_stride() const -> std::size_t;
+    auto allocate(std::size_t const& size) -> void;
+    auto release() -> void;
+
+  private:
+    std::uint8_t* m_buffer{nullptr};
+
+    std::int32_t m_width{0};
+    std::int32_t m_height{0};
+    std::int32_t m_channels{4};
+    pixel_format m_format{pixel_format::rgba8};
 
-    std::int32_t m_width;
-    std::int32_t m_height;
-    std::int32_t m_channels;
+    std::size_t                m_stride{0};
+    std::size_t                m_row_alignment{1};
+    std::size_t                m_capacity{0};
+    std::pmr::memory_resource* m_resource{std::pmr::get_default_resource()};
 };
 }  // namespace mno
 
@@ -12,11 +12,20 @@
 #include "mono/window.hpp"
 #include "mono/event.hpp"
 #include "mono/keyboard.hpp"
+#include "mono/cpu.hpp"
+#include "mono/random.hpp"
+#include "mono/spsc_queue.hpp"
+#include "mono/tile_scheduler.hpp"
 
 #include "mono/shader.hpp"
 #include "mono/buffer.hpp"
+#include "mono/image.hpp"
 #include "mono/texture.hpp"
+#include "mono/streaming_texture.hpp"
 #include "mono/framebuffer.hpp"
+#include "mono/double_buffered_target.hpp"
+#include "mono/readback.hpp"
 #include "mono/graphics_context.hpp"
+#include "mono/profiler.hpp"
 
 #endif // MONO_MONO_HPP
@@ -0,0 +1,156 @@
+/**
+ * @file   profiler.hpp
+ * @author Pratchaya Khansomboon (me@mononerv.dev)
+ * @brief  Per-pass CPU and GPU frame profiler with Chrome trace output.
+ * @date   2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ */
+#ifndef MONO_PROFILER_HPP
+#define MONO_PROFILER_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "common.hpp"
+
+namespace mno {
+// Times named passes on the CPU and, through GL_TIME_ELAPSED queries, on
+// the GPU. Every frame gets its own set of queries from a ring of depth
+// frames and results are only read once GL reports them available, so the
+// profiler never waits on the GPU. GPU timings therefore arrive a few
+// frames late through latest(). A frame whose queries are still in flight
+// when the ring wraps around is timed on the CPU only.
+//
+//     profiler.begin_frame();
+//     {
+//         auto scope = profiler.pass("koch3d");
+//         graphics->draw_triangles(quad);
+//     }
+//     profiler.end_frame();
+//
+// Elapsed queries can't nest, passes opened inside another pass get CPU
+// timings only. Needs a current GL context for its whole lifetime.
+class profiler {
+  public:
+    static constexpr std::size_t default_depth      = 4;
+    static constexpr std::size_t default_max_passes = 32;
+
+    // Times are milliseconds, starts are relative to the profiler's creation.
+    // gpu_ms is NaN when the pass wasn't measured on the GPU.
+    struct pass_timing {
+        std::string_view name;   // valid for the profiler's lifetime
+        std::uint32_t    depth;  // nesting level
+        f64              cpu_start_ms;
+        f64              cpu_ms;
+        f64              gpu_ms;
+    };
+    struct frame_timing {
+        std::uint64_t            frame{0};
+        f64                      cpu_start_ms{0.0};
+        f64                      cpu_ms{0.0};
+        f64                      gpu_start_ms{0.0};  // GL_TIMESTAMP at begin_frame() mapped to the CPU clock
+        f64                      gpu_ms{0.0};        // sum of the GPU timed passes
+        bool                     has_gpu{false};
+        std::vector<pass_timing> passes{};
+    };
+
+    // Ends its pass when it goes out of scope.
+    class scope {
+      public:
+        scope(profiler& owner, std::string_view const& name) : m_owner(&owner) { m_owner->begin_pass(name); }
+        ~scope() { if (m_owner != nullptr) m_owner->end_pass(); }
+        scope(scope const&) = delete;
+        auto operator=(scope const&) -> scope& = delete;
+        scope(scope&& other) noexcept : m_owner(std::exchange(other.m_owner, nullptr)) {}
+        auto operator=(scope&&) -> scope& = delete;
+
+      private:
+        profiler* m_owner;
+    };
+
+  public:
+    explicit profiler(std::size_t const& depth = default_depth,
+                      std::size_t const& max_passes = default_max_passes);
+    ~profiler();
+
+    profiler(profiler const&) = delete;
+    auto operator=(profiler const&) -> profiler& = delete;
+
+    auto begin_frame() -> void;
+    // Closes passes left open.
+    auto end_frame() -> void;
+    auto begin_pass(std::string_view const& name) -> void;
+    auto end_pass() -> void;
+    [[nodiscard]] auto pass(std::string_view const& name) -> scope { return {*this, name}; }
+
+    // Index of the current frame, or of the next one between frames.
+    auto frame() const -> std::uint64_t { return m_frame; }
+    // Most recent frame whose GPU results came back.
+    auto latest() const -> frame_timing const& { return m_latest; }
+    // Frames timed on the CPU only because their query slot was still busy.
+    auto cpu_only_frames() const -> std::uint64_t { return m_cpu_only_frames; }
+
+    // Keep up to max_frames finished frames for trace_json(), oldest dropped first.
+    auto start_trace(std::size_t const& max_frames = 600) -> void;
+    auto stop_trace() -> void { m_tracing = false; }
+    auto is_tracing() const -> bool { return m_tracing; }
+    // Chrome trace event format, opens in chrome://tracing and ui.perfetto.dev.
+    // GPU passes are laid out back to back from the frame's timestamp since
+    // only their durations are measured.
+    [[nodiscard]] auto trace_json() const -> std::string;
+    auto write_trace(std::filesystem::path const& path) const -> void;
+
+    [[nodiscard]] auto str() const -> std::string;
+
+  private:
+    struct slot {
+        std::vector<std::uint32_t> queries{};     // GL_TIME_ELAPSED queries
+        std::vector<std::size_t>   query_pass{};  // pass index of each issued query
+        std::uint32_t              timestamp{0};  // GL_TIMESTAMP query
+        std::size_t                used{0};
+        bool                       pending{false};
+        frame_timing               timing{};
+    };
+
+    auto now_ms() const -> f64;
+    auto intern(std::string_view const& name) -> std::string_view;
+    auto current() -> frame_timing&;
+    // Resolve every slot whose results are available, oldest first.
+    auto collect() -> void;
+    auto publish(frame_timing const& timing) -> void;
+
+  private:
+    std::chrono::steady_clock::time_point m_start;
+    f64                                   m_gpu_offset_ms{0.0};  // CPU ms minus GPU timestamp ms
+
+    std::vector<slot>  m_slots;
+    std::size_t        m_slot{0};
+    bool               m_use_slot{false};  // false when the frame is CPU only
+    frame_timing       m_cpu_frame{};      // timings of a CPU only frame
+    bool               m_in_frame{false};
+    std::uint64_t      m_frame{0};
+    std::uint64_t      m_cpu_only_frames{0};
+
+    // Open passes, the pass index and whether it owns the active GPU query
+    std::vector<std::pair<std::size_t, bool>> m_open{};
+    std::deque<std::string>                   m_names{};
+
+    frame_timing              m_latest{};
+    bool                      m_tracing{false};
+    std::size_t               m_trace_capacity{0};
+    std::deque<frame_timing>  m_trace{};
+};
+
+// Escapes quotes, backslashes and control characters for use inside a JSON
+// string, the surrounding quotes are left to the caller.
+auto json_escape(std::string_view const& str) -> std::string;
+}  // namespace mno
+
+#endif // MONO_PROFILER_HPP
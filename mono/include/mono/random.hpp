@@ -0,0 +1,62 @@
+/**
+ * @file   random.hpp
+ * @author Pratchaya Khansomboon (me@mononerv.dev)
+ * @brief  Counter-based random numbers for parallel fills.
+ * @date   2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ */
+#ifndef MONO_RANDOM_HPP
+#define MONO_RANDOM_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "common.hpp"
+#include "cpu.hpp"
+#include "image.hpp"
+#include "tile_scheduler.hpp"
+
+namespace mno {
+// Philox4x32-10, a counter-based generator: block n of a stream is a keyed
+// hash of n, so value i of the stream depends only on the seed and i. Any
+// range can be generated on any thread without sharing state and the output
+// never depends on how the work was split.
+//
+// Value i of a stream is word i % 4 of philox(seed, i / 4).
+[[nodiscard]] auto philox(std::uint64_t const& seed, std::uint64_t const& counter) -> std::array<std::uint32_t, 4>;
+// The full generator over a 128-bit counter and 64-bit key, the form the
+// published known-answer vectors use. The one above is this with the seed
+// as key and counter words 2 and 3 zero.
+[[nodiscard]] auto philox(std::array<std::uint32_t, 4> const& counter, std::array<std::uint32_t, 2> const& key)
+    -> std::array<std::uint32_t, 4>;
+
+// out[i] = value first + i of the stream.
+using random_kernel = auto (*)(std::uint64_t seed, std::uint64_t first, std::uint32_t* out, std::size_t count) -> void;
+[[nodiscard]] auto random_kernel_for(simd_level const& level) -> random_kernel;
+auto random_u32(std::uint64_t const& seed, std::uint64_t const& first, std::uint32_t* out,
+                std::size_t const& count) -> void;
+
+// A value v is a hit for density when (v >> 8) < random_threshold(density),
+// which is what shaders/410.noise.gl.frag compares against as well.
+[[nodiscard]] auto random_threshold(f32 const& density) -> std::uint32_t;
+
+// Pixel (x, y) is white with probability density and black otherwise, it
+// takes value y * width + x of the stream so every tiling and the noise
+// shader produce the same image.
+auto random_fill(image& image, std::uint64_t const& seed, f32 const& density = 0.5f) -> void;
+auto random_fill(image& image, std::uint64_t const& seed, f32 const& density, tile_scheduler& scheduler) -> void;
+auto random_fill(image& image, std::uint64_t const& seed, f32 const& density,
+                 std::int32_t const& x0, std::int32_t const& y0, std::int32_t const& x1, std::int32_t const& y1) -> void;
+
+// Bit-packed boards, every bit of out is set with probability density
+// rounded to 1/65536. The bits compare a 16-bit random number per cell
+// against the density one bit plane at a time, plane pair p of word i is
+// block (p << 40) + first + i, and planes below the lowest set bit of the
+// density are never generated, so 0.5 costs one block per 64 cells.
+auto random_bits(std::uint64_t const& seed, std::uint64_t const& first, std::uint64_t* out,
+                 std::size_t const& count, f32 const& density = 0.5f) -> void;
+}  // namespace mno
+
+#endif // MONO_RANDOM_HPP
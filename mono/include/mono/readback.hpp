@@ -0,0 +1,86 @@
+/**
+ * @file   readback.hpp
+ * @author Pratchaya Khansomboon (me@mononerv.dev)
+ * @brief  Asynchronous framebuffer readback through a ring of pixel buffers.
+ * @date   2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ */
+#ifndef MONO_READBACK_HPP
+#define MONO_READBACK_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "common.hpp"
+#include "image.hpp"
+#include "framebuffer.hpp"
+
+namespace mno {
+// glReadPixels into a pixel pack buffer returns as soon as the copy is
+// queued, a fence tells when the GPU is done with it. With the default
+// depth of 3 the pixels of frame N - 2 are mapped while frame N renders so
+// capturing never waits on the GPU.
+//
+//     readback.capture(framebuffer);
+//     while (readback.fetch(image)) write(image, readback.frame());
+class readback {
+  public:
+    static constexpr std::size_t default_depth = 3;
+
+  public:
+    readback(std::int32_t const& width, std::int32_t const& height,
+             std::size_t const& depth = default_depth);
+    ~readback() noexcept;
+
+    readback(readback const&) = delete;
+    auto operator=(readback const&) -> readback& = delete;
+
+    // Queue a copy of the framebuffer's colour attachment, false when every
+    // buffer still holds a frame that hasn't been fetched yet. Throws
+    // std::invalid_argument unless the framebuffer has the readback's size.
+    auto capture(mno::framebuffer const& framebuffer) -> bool;
+    // Copy out the oldest captured frame if the GPU is done with it, or wait
+    // for it when wait is set. Rows are bottom to top like the framebuffer.
+    // False while the frame is still pending, or when waiting for it or
+    // mapping its buffer failed, then the frame is dropped and counted in
+    // dropped().
+    auto fetch(mno::image& image, bool const& wait = false) -> bool;
+
+    // Drops all pending frames.
+    auto resize(std::int32_t const& width, std::int32_t const& height) -> void;
+
+    auto width()  const -> std::int32_t { return m_width; }
+    auto height() const -> std::int32_t { return m_height; }
+    auto pending() const -> std::size_t { return m_count; }
+    // Index of the last fetched frame, counted from the first capture.
+    auto frame() const -> std::uint64_t { return m_frame; }
+    // Frames that failed to wait or map, skipped over by fetch().
+    auto dropped() const -> std::uint64_t { return m_dropped; }
+
+    [[nodiscard]] auto str() const -> std::string;
+
+  private:
+    struct slot {
+        std::uint32_t buffer{0};
+        void*         fence{nullptr};  // GLsync
+        std::uint64_t frame{0};
+    };
+
+    auto allocate() -> void;
+    auto release() -> void;
+
+  private:
+    std::int32_t      m_width;
+    std::int32_t      m_height;
+    std::vector<slot> m_slots;
+    std::size_t       m_head{0};   // oldest pending slot
+    std::size_t       m_count{0};  // pending slots
+    std::uint64_t     m_captured{0};
+    std::uint64_t     m_frame{0};
+    std::uint64_t     m_dropped{0};
+};
+}  // namespace mno
+
+#endif // MONO_READBACK_HPP
@@ -10,7 +10,11 @@
 #define MONO_SHADER_HPP
 
 #include <cstdint>
+#include <filesystem>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <type_traits>
 
 #include "common.hpp"
 #include "glm/gtc/type_ptr.hpp"
@@ -26,6 +30,13 @@ class shader {
   public:
     static auto make(std::string const& vertex_source, std::string const& fragment_source) -> local<shader>;
     static auto make() -> local<shader>;
+    // Reads both stages from source files, throws when a file can't be read.
+    static auto load(std::filesystem::path const& vertex_file, std::filesystem::path const& fragment_file) -> local<shader>;
+
+    // Linked programs are cached on disk as driver binaries keyed by the
+    // sources and the driver, an empty directory disables the cache.
+    static auto set_cache_directory(std::filesystem::path const& directory) -> void;
+    static auto cache_directory() -> std::filesystem::path const&;
 
     // shader types
     // https://www.khronos.org/opengl/wiki/OpenGL_Type
@@ -47,6 +58,15 @@ class shader {
         mat2, mat3, mat4,
     };
 
+    // Pre-resolved uniform location, look it up once with uniform<T>() and
+    // reuse it in the render loop to skip the name lookup entirely. A missing
+    // uniform or one of another type gives an invalid handle.
+    template <typename T>
+    struct uniform_handle {
+        mno::i32 location{-1};
+        [[nodiscard]] auto is_valid() const -> bool { return location >= 0; }
+    };
+
   public:
     shader(std::string const& vertex_source, std::string const& fragment_source);
     ~shader();
@@ -54,31 +74,86 @@ class shader {
     auto bind() const -> void;
     auto unbind() const -> void;
 
-    // uniform uploads
+    // uniform uploads, locations come from a table reflected at link time
   public:
-    auto num(std::string const& name, mno::u32 const& value) -> void;
-    auto num(std::string const& name, mno::i32 const& value) -> void;
-    auto num(std::string const& name, mno::f32 const& value) -> void;
-    auto num(std::string const& name, mno::i32 const& count, float const* value) -> void;
+    auto num(std::string_view const& name, mno::u32 const& value) -> void;
+    auto num(std::string_view const& name, mno::i32 const& value) -> void;
+    auto num(std::string_view const& name, mno::f32 const& value) -> void;
+    auto num(std::string_view const& name, mno::i32 const& count, float const* value) -> void;
 
-    auto vec2(std::string const& name, glm::vec2 const& value) -> void;
-    auto vec3(std::string const& name, glm::vec3 const& value) -> void;
-    auto vec4(std::string const& name, glm::vec3 const& value) -> void;
+    auto vec2(std::string_view const& name, glm::vec2 const& value) -> void;
+    auto vec3(std::string_view const& name, glm::vec3 const& value) -> void;
+    auto vec4(std::string_view const& name, glm::vec4 const& value) -> void;
 
-    auto mat2(std::string const& name, glm::mat2 const& value, bool const& transpose = false) -> void;
-    auto mat3(std::string const& name, glm::mat3 const& value, bool const& transpose = false) -> void;
-    auto mat4(std::string const& name, glm::mat4 const& value, bool const& transpose = false) -> void;
+    auto mat2(std::string_view const& name, glm::mat2 const& value, bool const& transpose = false) -> void;
+    auto mat3(std::string_view const& name, glm::mat3 const& value, bool const& transpose = false) -> void;
+    auto mat4(std::string_view const& name, glm::mat4 const& value, bool const& transpose = false) -> void;
+
+    // Point the uniform block at a uniform_buffer binding, false when the
+    // program doesn't use the block.
+    auto bind_block(std::string_view const& name, mno::u32 const& binding) -> bool;
+
+    // typed handle uploads
+  public:
+    template <typename T>
+    [[nodiscard]] auto uniform(std::string_view const& name) const -> uniform_handle<T> {
+        return {resolve(name, type_of<T>())};
+    }
+
+    auto set(uniform_handle<mno::u32> const& uniform, mno::u32 const& value) -> void;
+    auto set(uniform_handle<mno::i32> const& uniform, mno::i32 const& value) -> void;
+    auto set(uniform_handle<mno::f32> const& uniform, mno::f32 const& value) -> void;
+    auto set(uniform_handle<glm::vec2> const& uniform, glm::vec2 const& value) -> void;
+    auto set(uniform_handle<glm::vec3> const& uniform, glm::vec3 const& value) -> void;
+    auto set(uniform_handle<glm::vec4> const& uniform, glm::vec4 const& value) -> void;
+    auto set(uniform_handle<glm::mat2> const& uniform, glm::mat2 const& value, bool const& transpose = false) -> void;
+    auto set(uniform_handle<glm::mat3> const& uniform, glm::mat3 const& value, bool const& transpose = false) -> void;
+    auto set(uniform_handle<glm::mat4> const& uniform, glm::mat4 const& value, bool const& transpose = false) -> void;
 
   public:
     [[nodiscard]] auto str() const -> std::string;
 
   private:
+    struct uniform_info {
+        mno::i32     location;
+        shader::type data_type;
+        mno::i32     count;
+    };
+    // Transparent hash so lookups by std::string_view don't allocate
+    struct string_hash {
+        using is_transparent = void;
+        auto operator()(std::string_view const& str) const -> std::size_t {
+            return std::hash<std::string_view>{}(str);
+        }
+    };
+    using uniform_map = std::unordered_map<std::string, uniform_info, string_hash, std::equal_to<>>;
+
+    template <typename T>
+    static constexpr auto type_of() -> shader::type {
+        if constexpr (std::is_same_v<T, mno::u32>)  return type::u32;
+        else if constexpr (std::is_same_v<T, mno::i32>)  return type::i32;
+        else if constexpr (std::is_same_v<T, mno::f32>)  return type::f32;
+        else if constexpr (std::is_same_v<T, glm::vec2>) return type::vec2;
+        else if constexpr (std::is_same_v<T, glm::vec3>) return type::vec3;
+        else if constexpr (std::is_same_v<T, glm::vec4>) return type::vec4;
+        else if constexpr (std::is_same_v<T, glm::mat2>) return type::mat2;
+        else if constexpr (std::is_same_v<T, glm::mat3>) return type::mat3;
+        else if constexpr (std::is_same_v<T, glm::mat4>) return type::mat4;
+        else return type::none;
+    }
+
     static auto compile(mno::u32 const& type, char const* source) -> mno::u32;
     static auto link(mno::u32 const& fs, mno::u32 const& vs) -> mno::u32;
-    [[nodiscard]] auto uniform_location(std::string const& name) const -> mno::i32;
+    static auto cache_path(std::string const& vertex_source, std::string const& fragment_source) -> std::filesystem::path;
+    static auto load_binary(std::filesystem::path const& path) -> mno::u32;
+    static auto save_binary(mno::u32 const& program, std::filesystem::path const& path) -> void;
+    auto reflect() -> void;
+    [[nodiscard]] auto resolve(std::string_view const& name, shader::type const& expected) const -> mno::i32;
+    [[nodiscard]] auto uniform_location(std::string_view const& name) const -> mno::i32;
 
   private:
-    mno::u32 m_id;
+    mno::u32    m_id;
+    uniform_map m_uniforms{};
 };
 }  // namespace mno
 
@@ -0,0 +1,74 @@
+/**
+ * @file   spsc_queue.hpp
+ * @author Pratchaya Khansomboon (me@mononerv.dev)
+ * @brief  Bounded lock-free single producer single consumer queue.
+ * @date   2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ */
+#ifndef MONO_SPSC_QUEUE_HPP
+#define MONO_SPSC_QUEUE_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+namespace mno {
+// Ring buffer of Capacity preallocated slots. One thread pushes and one
+// thread pops, neither ever blocks or allocates. Head and tail sit on their
+// own cache lines and each side keeps a cached copy of the other's index,
+// so the shared lines are only touched when the cached view runs out.
+template <typename T, std::size_t Capacity>
+class spsc_queue {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "spsc_queue: capacity must be a power of two");
+
+  public:
+    static constexpr std::size_t cache_line = 64;
+
+  public:
+    spsc_queue() = default;
+    spsc_queue(spsc_queue const&) = delete;
+    auto operator=(spsc_queue const&) -> spsc_queue& = delete;
+
+    // Producer side, false when the queue is full.
+    auto try_push(T const& value) -> bool {
+        auto const head = m_head.load(std::memory_order_relaxed);
+        if (head - m_cached_tail == Capacity) {
+            m_cached_tail = m_tail.load(std::memory_order_acquire);
+            if (head - m_cached_tail == Capacity) return false;
+        }
+        m_slots[head & (Capacity - 1)] = value;
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side, false when the queue is empty.
+    auto try_pop(T& value) -> bool {
+        auto const tail = m_tail.load(std::memory_order_relaxed);
+        if (tail == m_cached_head) {
+            m_cached_head = m_head.load(std::memory_order_acquire);
+            if (tail == m_cached_head) return false;
+        }
+        value = std::move(m_slots[tail & (Capacity - 1)]);
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Only exact when neither side is running.
+    auto size() const -> std::size_t {
+        return m_head.load(std::memory_order_acquire) - m_tail.load(std::memory_order_acquire);
+    }
+    auto empty() const -> bool { return size() == 0; }
+    static constexpr auto capacity() -> std::size_t { return Capacity; }
+
+  private:
+    alignas(cache_line) std::atomic<std::size_t> m_head{0};
+    std::size_t                                  m_cached_tail{0};  // producer's view of m_tail
+    alignas(cache_line) std::atomic<std::size_t> m_tail{0};
+    std::size_t                                  m_cached_head{0};  // consumer's view of m_head
+    alignas(cache_line) std::array<T, Capacity>  m_slots{};
+};
+}  // namespace mno
+
+#endif // MONO_SPSC_QUEUE_HPP
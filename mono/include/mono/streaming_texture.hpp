@@ -0,0 +1,87 @@
+/**
+ * @file   streaming_texture.hpp
+ * @author Pratchaya Khansomboon (me@mononerv.dev)
+ * @brief  Texture fed from the CPU through a ring of pixel unpack buffers.
+ * @date   2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ */
+#ifndef MONO_STREAMING_TEXTURE_HPP
+#define MONO_STREAMING_TEXTURE_HPP
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "common.hpp"
+#include "image.hpp"
+#include "texture.hpp"
+
+namespace mno {
+// Storage is allocated once and only the rectangles marked dirty are sent
+// with glTexSubImage2D. Each upload goes through the next buffer of a PBO
+// ring, the buffer is orphaned before it's mapped so the driver never has
+// to wait for the GPU to finish reading the previous contents. This keeps
+// to GL 4.1, persistent mapping needs 4.4 which macOS doesn't have.
+class streaming_texture {
+  public:
+    static constexpr std::size_t default_depth = 3;
+    // Past this many pending rectangles a single bounding box is uploaded.
+    static constexpr std::size_t max_rects = 64;
+
+  public:
+    streaming_texture(std::int32_t const& width, std::int32_t const& height,
+                      std::size_t const& depth = default_depth,
+                      texture_format const& format = texture_format::rgba8);
+    ~streaming_texture() noexcept;
+
+    streaming_texture(streaming_texture const&) = delete;
+    auto operator=(streaming_texture const&) -> streaming_texture& = delete;
+
+    auto bind(std::uint32_t const& id = 0) const -> void { m_texture->bind(id); }
+    auto texture() const -> ref<mno::texture> { return m_texture; }
+    auto width()  const -> std::int32_t { return m_texture->width(); }
+    auto height() const -> std::int32_t { return m_texture->height(); }
+
+    // Reallocates the texture, everything is dirty afterwards.
+    auto resize(std::int32_t const& width, std::int32_t const& height) -> void;
+
+    // Thread safe, render workers can mark tiles as they finish them.
+    auto mark_dirty(std::int32_t const& x0, std::int32_t const& y0,
+                    std::int32_t const& x1, std::int32_t const& y1) -> void;
+    auto mark_dirty() -> void;
+    // Upload the dirty rectangles of image, must be the texture's size.
+    // Call from the thread owning the GL context.
+    auto flush(mno::image const& image) -> void;
+    // Upload the whole image right away.
+    auto update(mno::image const& image) -> void;
+    // Uploads whose buffer couldn't be mapped, their rectangles stay dirty.
+    auto failed() const -> std::uint64_t { return m_failed; }
+
+    [[nodiscard]] auto str() const -> std::string;
+
+  private:
+    struct rect {
+        std::int32_t x0;
+        std::int32_t y0;
+        std::int32_t x1;
+        std::int32_t y1;
+    };
+
+    auto upload(mno::image const& image, rect const& r) -> void;
+
+  private:
+    ref<mno::texture>          m_texture;
+    std::vector<std::uint32_t> m_buffers;
+    std::vector<std::size_t>   m_capacity;
+    std::size_t                m_next{0};
+    std::uint64_t              m_failed{0};
+
+    std::mutex                 m_mutex{};
+    std::vector<rect>          m_dirty{};
+    std::vector<rect>          m_flushing{};
+};
+}  // namespace mno
+
+#endif // MONO_STREAMING_TEXTURE_HPP
@@ -10,6 +10,7 @@
 #define MONO_TEXTURE_HPP
 
 #include <cstdint>
+#include <string>
 
 #include "common.hpp"
 #include "image.hpp"
@@ -21,10 +22,40 @@ enum class texture_flag : std::uint64_t {
     mag_nearest = set_bit(2),
 };
 
+enum class texture_filter : std::uint32_t {
+    nearest = 0,
+    linear,
+};
+
+// Internal storage format. Single channel formats are sampled as
+// (r, r, r, 1) so they display as greyscale.
+enum class texture_format : std::uint32_t {
+    rgba8 = 0,
+    r8,
+    r16,
+    rgba16,
+    r32f,
+    rgba16f,
+    rgba32f,
+};
+
+// Storage format that holds an image's pixels without losing precision.
+[[nodiscard]] auto texture_format_of(pixel_format const& format) -> texture_format;
+[[nodiscard]] auto to_string(texture_format const& format) -> std::string;
+
+// GL format and type enums describing pixels of an image during transfers.
+struct pixel_transfer {
+    std::uint32_t format;
+    std::uint32_t type;
+};
+[[nodiscard]] auto pixel_transfer_of(pixel_format const& format) -> pixel_transfer;
+
 class texture {
   public:
     explicit texture(mno::image const& image);
-    texture(std::int32_t const& width, std::int32_t const& height);
+    texture(mno::image const& image, texture_format const& format);
+    texture(std::int32_t const& width, std::int32_t const& height,
+            texture_format const& format = texture_format::rgba8);
     ~texture();
 
     auto bind(std::uint32_t const& id = 0) const -> void;
@@ -32,14 +63,18 @@ class texture {
 
     auto set_image(mno::image const& image) -> void;
     auto resize(std::int32_t const& width, std::int32_t const& height) -> void;
+    // Minification and magnification filter, kept across resizes.
+    auto set_filter(texture_filter const& filter) -> void;
     [[nodiscard]] auto buffer() const -> std::uint32_t { return m_buffer; }
     auto width()  const -> std::int32_t { return m_width; }
     auto height() const -> std::int32_t { return m_height; }
+    auto format() const -> texture_format { return m_format; }
 
   private:
-    std::uint32_t m_buffer{};
-    std::int32_t  m_width;
-    std::int32_t  m_height;
+    std::uint32_t  m_buffer{};
+    std::int32_t   m_width;
+    std::int32_t   m_height;
+    texture_format m_format{texture_format::rgba8};
 };
 }  // namespace mno
 
@@ -0,0 +1,100 @@
+/**
+ * @file   tile_scheduler.hpp
+ * @author Pratchaya Khansomboon (me@mononerv.dev)
+ * @brief  Tile based work-stealing scheduler for CPU image rendering.
+ * @date   2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ */
+#ifndef MONO_TILE_SCHEDULER_HPP
+#define MONO_TILE_SCHEDULER_HPP
+
+#include <cstdint>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "common.hpp"
+#include "image.hpp"
+
+namespace mno {
+// Pixel rectangle [x0, x1) x [y0, y1), index is the tile's position in row major order.
+struct tile {
+    std::int32_t  x0;
+    std::int32_t  y0;
+    std::int32_t  x1;
+    std::int32_t  y1;
+    std::uint32_t index;
+
+    auto width()  const -> std::int32_t { return x1 - x0; }
+    auto height() const -> std::int32_t { return y1 - y0; }
+};
+
+// Splits a frame into tiles and runs a callback for each on a pool of
+// workers. Every worker owns a deque, pops from the front of its own and
+// steals from the back of the others once it runs dry, so expensive
+// regions get spread out without a central queue.
+class tile_scheduler {
+  public:
+    using tile_fn = std::function<void(tile const&)>;
+
+    // 64x64 RGBA8 tiles are 16 KiB and stay resident in L1/L2 while written.
+    static constexpr std::int32_t default_tile_size = 64;
+
+  public:
+    explicit tile_scheduler(std::uint32_t const& threads = std::thread::hardware_concurrency(),
+                            std::int32_t const& tile_size = default_tile_size);
+    ~tile_scheduler();
+
+    tile_scheduler(tile_scheduler const&) = delete;
+    auto operator=(tile_scheduler const&) -> tile_scheduler& = delete;
+
+    // Blocks until every tile is done, the calling thread works as well.
+    // The first exception thrown by fn is rethrown here.
+    auto run(std::int32_t const& width, std::int32_t const& height, tile_fn const& fn) -> void;
+    auto run(mno::image const& image, tile_fn const& fn) -> void;
+
+    // Clamped to at least one pixel like the constructor argument.
+    auto set_tile_size(std::int32_t const& size) -> void { m_tile_size = std::max(size, 1); }
+    auto tile_size() const -> std::int32_t { return m_tile_size; }
+    // Worker threads plus the calling thread.
+    auto thread_count() const -> std::uint32_t { return std::uint32_t(m_workers.size() + 1); }
+
+    [[nodiscard]] auto str() const -> std::string;
+
+  private:
+    struct queue {
+        std::mutex       mutex;
+        std::deque<tile> tiles;
+    };
+
+    auto worker(std::size_t const& index) -> void;
+    auto work(std::size_t const& index) -> void;
+    auto pop(std::size_t const& index, tile& out) -> bool;
+    auto steal(std::size_t const& index, tile& out) -> bool;
+
+  private:
+    std::int32_t                m_tile_size;
+    std::vector<std::thread>    m_workers{};
+    std::vector<local<queue>>   m_queues{};
+
+    std::mutex                  m_mutex{};
+    std::condition_variable     m_start{};
+    std::condition_variable     m_done{};
+    std::uint64_t               m_generation{0};
+    bool                        m_stop{false};
+
+    tile_fn const*              m_fn{nullptr};
+    std::atomic<std::size_t>    m_pending{0};
+    std::exception_ptr          m_error{nullptr};
+};
+}  // namespace mno
+
+#endif // MONO_TILE_SCHEDULER_HPP
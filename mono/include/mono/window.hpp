@@ -9,11 +9,13 @@
 #ifndef MONO_WINDOW_HPP
 #define MONO_WINDOW_HPP
 
+#include <array>
+#include <atomic>
 #include <cstdint>
 #include <stdexcept>
 #include <string>
+#include <utility>
 #include <vector>
-#include <unordered_map>
 #include <type_traits>
 #include <functional>
 #include <concepts>
@@ -22,6 +24,7 @@
 #include "event.hpp"
 #include "keyboard.hpp"
 #include "graphics_context.hpp"
+#include "spsc_queue.hpp"
 
 #define GLFW_INCLUDE_NONE
 #include "GLFW/glfw3.h"
@@ -34,15 +37,28 @@ struct window_props {
     std::int32_t height = 480;
     std::int32_t xpos{INT32_MIN};
     std::int32_t ypos{INT32_MIN};
+    // Hidden window used only for its GL context, render into a framebuffer.
+    // Without a display on Linux GLFW's null platform with OSMesa is used.
+    bool         headless{false};
+    // Run the listeners at the end of poll(), turn off to drain events() or
+    // call dispatch() from another thread instead.
+    bool         dispatch_on_poll{true};
 };
 
 template <typename T>
 concept EventFunc = std::is_invocable_r_v<void, T, event const&>;
 
+// GLFW callbacks only record events, they are copied into a preallocated
+// ring buffer and listeners run later in one batch. The ring is a single
+// producer single consumer queue, the producer is the thread calling poll()
+// and the consumer may be any one other thread. Listener lists are indexed
+// by event_type, so dispatch neither hashes nor allocates. drop_event is the
+// exception since it carries the dropped paths.
 class window {
   public:
-    using event_fn  = std::function<void(event const&)>;
-    using event_map = std::unordered_map<std::size_t, event_fn>;
+    using event_fn    = std::function<void(event const&)>;
+    using event_list  = std::vector<std::pair<std::size_t, event_fn>>;
+    using event_queue = spsc_queue<event_variant, 1024>;
 
   public:
     explicit window(window_props const& props = {});
@@ -57,6 +73,7 @@ class window {
     [[nodiscard]] auto ypos() const -> std::int32_t { return m_data.ypos; }
     [[nodiscard]] auto xscale() const -> mno::f32 { return m_data.xscale; }
     [[nodiscard]] auto yscale() const -> mno::f32 { return m_data.yscale; }
+    [[nodiscard]] auto is_headless() const -> bool { return m_data.headless; }
     [[nodiscard]] auto graphics_context() -> ref<mno::graphics_context> { return m_graphics_context; };
 
     auto set_position(std::int32_t const& x, std::int32_t const& y) -> void;
@@ -68,26 +85,25 @@ class window {
     auto content_scale(mno::f32& x, mno::f32& y) const -> void;
 
     auto swap() -> void;
+    // Process pending GLFW events and, with dispatch_on_poll, run the listeners.
     auto poll() -> void;
+    // Run the listeners for every queued event on the calling thread. Don't
+    // add or remove listeners while another thread dispatches. Listeners
+    // added or removed by a listener take effect once the batch is done.
+    auto dispatch() -> void;
+    auto events() -> event_queue& { return m_data.queue; }
+    // Events lost because the queue was full.
+    [[nodiscard]] auto dropped_events() const -> std::size_t { return m_data.dropped.load(std::memory_order_relaxed); }
     [[nodiscard]] auto time() const -> mno::f64;
 
     auto mouse_pos(mno::f64& x, mno::f64& y) const -> void;
     [[nodiscard]] auto keystate(mno::key const& key) const -> mno::keystate;
 
     auto add_event_listener(event_type const& type, EventFunc auto const& func) -> void {
-        auto const id = std::size_t(&func);
-        if (m_data.events.find(type) == m_data.events.end()) {
-            std::unordered_map<std::size_t, event_fn> fns{{id, func}};
-            m_data.events.insert({type, fns});
-        } else {
-            m_data.events[type].insert({id, func});
-        }
+        change_listener(type, std::size_t(&func), func);
     }
     auto remove_event_listener(event_type const& type, EventFunc auto const& func) -> void {
-        auto const id = std::size_t(&func);
-        auto fns = m_data.events.find(type);
-        if (fns != std::end(m_data.events))
-            fns->second.erase(id);
+        change_listener(type, std::size_t(&func), nullptr);
     }
 
   public:
@@ -115,15 +131,29 @@ class window {
         std::int32_t ypos;
         mno::f32     xscale;
         mno::f32     yscale;
+        bool         headless;
 
-        std::unordered_map<event_type, event_map> events;
+        event_queue              queue;
+        std::atomic<std::size_t> dropped{0};
     };
     data m_data{};
+    bool m_dispatch_on_poll{true};
+    std::array<event_list, event_type_count> m_listeners{};
+    // Changes made while dispatching, applied after the batch so the lists
+    // never reallocate under the loop. An empty fn removes the listener.
+    bool m_is_dispatching{false};
+    std::vector<std::pair<event_type, std::pair<std::size_t, event_fn>>> m_pending{};
 
   private:
+    // Adds fn under id, or removes id when fn is empty.
+    auto change_listener(event_type const& type, std::size_t const& id, event_fn const& fn) -> void;
+
     static auto user_ptr(GLFWwindow* window) -> window::data* {
         return static_cast<window::data*>(glfwGetWindowUserPointer(window));
     }
+    // Called from the GLFW callbacks, counts the event as dropped when the queue is full.
+    template <typename Event>
+    static auto enqueue(GLFWwindow* window, Event const& event) -> void;
 };
 }  // namespace mno
 
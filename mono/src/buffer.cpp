@@ -8,6 +8,7 @@
  */
 #include "buffer.hpp"
 #include <numeric>
+#include <stdexcept>
 
 #include "glad/glad.h"
 #include "spdlog/spdlog.h"
@@ -69,6 +70,37 @@ auto index_buffer::make(void const* data, std::uint32_t const& size, std::int32_
     return make_local<index_buffer>(data, size, count);
 }
 
+uniform_buffer::uniform_buffer(std::uint32_t const& size, std::uint32_t const& binding)
+    : m_size(size), m_binding(binding) {
+    glGenBuffers(1, &m_buffer);
+    glBindBuffer(GL_UNIFORM_BUFFER, m_buffer);
+    glBufferData(GL_UNIFORM_BUFFER, size, nullptr, GL_DYNAMIC_DRAW);
+    glBindBufferBase(GL_UNIFORM_BUFFER, binding, m_buffer);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+uniform_buffer::~uniform_buffer() noexcept {
+    glDeleteBuffers(1, &m_buffer);
+}
+
+auto uniform_buffer::bind() const -> void { glBindBuffer(GL_UNIFORM_BUFFER, m_buffer); }
+auto uniform_buffer::unbind() const -> void { glBindBuffer(GL_UNIFORM_BUFFER, 0); }
+
+auto uniform_buffer::update(void const* data, std::uint32_t const& size) -> void {
+    if (size > m_size) throw std::runtime_error("uniform_buffer: update larger than the buffer");
+    bind();
+    if (size == m_size) {
+        glBufferData(GL_UNIFORM_BUFFER, size, data, GL_DYNAMIC_DRAW);
+    } else {
+        glBufferData(GL_UNIFORM_BUFFER, m_size, nullptr, GL_DYNAMIC_DRAW);
+        glBufferSubData(GL_UNIFORM_BUFFER, 0, size, data);
+    }
+    unbind();
+}
+
+auto uniform_buffer::make(std::uint32_t const& size, std::uint32_t const& binding) -> local<uniform_buffer> {
+    return make_local<uniform_buffer>(size, binding);
+}
+
 array_buffer::array_buffer() {
     glGenVertexArrays(1, &m_buffer);
     glBindVertexArray(m_buffer);
@@ -0,0 +1,58 @@
+/**
+ * @file   cpu.cpp
+ * @author Pratchaya Khansomboon (me@mononerv.dev)
+ * @brief  Host CPU feature queries.
+ * @date   2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ */
+#include "cpu.hpp"
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
+
+namespace mno {
+static auto detect_simd_level() -> simd_level {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return simd_level::avx2;
+    if (__builtin_cpu_supports("sse2")) return simd_level::sse2;
+    return simd_level::scalar;
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    std::int32_t info[4]{};
+    __cpuid(info, 0);
+    auto const max_leaf = info[0];
+    __cpuid(info, 1);
+    auto const has_sse2 = (info[3] & (1 << 26)) != 0;
+    auto const has_avx  = (info[2] & (1 << 28)) != 0;
+    auto const has_osxsave = (info[2] & (1 << 27)) != 0;
+    auto has_avx2 = false;
+    if (max_leaf >= 7 && has_avx && has_osxsave) {
+        // Make sure the OS saves the YMM registers on context switch
+        auto const xcr0 = _xgetbv(0);
+        __cpuidex(info, 7, 0);
+        has_avx2 = (xcr0 & 0x6) == 0x6 && (info[1] & (1 << 5)) != 0;
+    }
+    if (has_avx2) return simd_level::avx2;
+    if (has_sse2) return simd_level::sse2;
+    return simd_level::scalar;
+#else
+    return simd_level::scalar;
+#endif
+}
+
+auto cpu_simd_level() -> simd_level {
+    static auto const level = detect_simd_level();
+    return level;
+}
+
+auto to_string(simd_level const& level) -> std::string {
+    switch (level) {
+        case simd_level::avx2:   return "avx2";
+        case simd_level::sse2:   return "sse2";
+        case simd_level::scalar: return "scalar";
+        default: return "unknown";
+    }
+}
+}  // namespace mno
@@ -0,0 +1,56 @@
+/**
+ * @file   double_buffered_target.cpp
+ * @author Pratchaya Khansomboon (me@mononerv.dev)
+ * @brief  Ping-pong framebuffer pair for iterative GPU simulations.
+ * @date   2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ */
+#include "double_buffered_target.hpp"
+
+#include <utility>
+
+#include "glad/glad.h"
+
+namespace mno {
+static auto make_target(std::int32_t const& width, std::int32_t const& height,
+                        texture_format const& format) -> local<framebuffer> {
+    return make_local<framebuffer>(make_ref<mno::texture>(width, height, format));
+}
+
+double_buffered_target::double_buffered_target(std::int32_t const& width, std::int32_t const& height,
+                                               texture_format const& format)
+    : m_format(format),
+      m_front(make_target(width, height, format)),
+      m_back(make_target(width, height, format)) {}
+
+auto double_buffered_target::swap() -> void {
+    std::swap(m_front, m_back);
+}
+
+auto double_buffered_target::resize(std::int32_t const& width, std::int32_t const& height) -> void {
+    if (width == this->width() && height == this->height()) return;
+    m_front->resize(width, height);
+    m_back->resize(width, height);
+    m_front->unbind();
+}
+
+auto double_buffered_target::run(std::int32_t const& generations, std::uint32_t const& unit,
+                                 std::function<void()> const& pass) -> void {
+    glViewport(0, 0, width(), height());
+    for (std::int32_t i = 0; i < generations; i++) {
+        m_back->bind();
+        m_front->texture()->bind(unit);
+        pass();
+        swap();
+    }
+    m_front->unbind();
+}
+
+auto double_buffered_target::str() const -> std::string {
+    std::string str{"mno::double_buffered_target { "};
+    str += "size: " + std::to_string(m_front->width()) + "x" + std::to_string(m_front->height()) + ", ";
+    str += "format: " + to_string(m_format) + " }";
+    return str;
+}
+}  // namespace mno
@@ -7,15 +7,37 @@
  * @copyright Copyright (c) 2022
  */
 #include "framebuffer.hpp"
+#include <stdexcept>
+#include <string>
 
 #include "glad/glad.h"
 
 namespace mno {
+static auto status_name(GLenum const& status) -> std::string {
+    switch (status) {
+        case GL_FRAMEBUFFER_UNDEFINED:                     return "GL_FRAMEBUFFER_UNDEFINED";
+        case GL_FRAMEBUFFER_INCOMPLETE_ATTACHMENT:         return "GL_FRAMEBUFFER_INCOMPLETE_ATTACHMENT";
+        case GL_FRAMEBUFFER_INCOMPLETE_MISSING_ATTACHMENT: return "GL_FRAMEBUFFER_INCOMPLETE_MISSING_ATTACHMENT";
+        case GL_FRAMEBUFFER_INCOMPLETE_DRAW_BUFFER:        return "GL_FRAMEBUFFER_INCOMPLETE_DRAW_BUFFER";
+        case GL_FRAMEBUFFER_INCOMPLETE_READ_BUFFER:        return "GL_FRAMEBUFFER_INCOMPLETE_READ_BUFFER";
+        case GL_FRAMEBUFFER_UNSUPPORTED:                   return "GL_FRAMEBUFFER_UNSUPPORTED";
+        case GL_FRAMEBUFFER_INCOMPLETE_MULTISAMPLE:        return "GL_FRAMEBUFFER_INCOMPLETE_MULTISAMPLE";
+        default:                                           return "status " + std::to_string(status);
+    }
+}
+
 framebuffer::framebuffer(std::int32_t const& width, std::int32_t const& height)
         : framebuffer(make_ref<mno::texture>(width, height),make_ref<mno::renderbuffer>(width, height)) {}
 
 framebuffer::framebuffer(ref<mno::texture> const& texture, ref<mno::renderbuffer> const& render)
         : m_texture(texture), m_render(render) {
+    GLint max_size = 0;
+    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &max_size);
+    if (texture->width() > max_size || texture->height() > max_size) {
+        throw std::runtime_error("Framebuffer " + std::to_string(texture->width()) + "x" +
+                                 std::to_string(texture->height()) + " exceeds GL_MAX_TEXTURE_SIZE " +
+                                 std::to_string(max_size));
+    }
     glGenFramebuffers(1, &m_buffer);
     glBindFramebuffer(GL_FRAMEBUFFER, m_buffer);
     m_texture->bind();
@@ -24,10 +46,19 @@ framebuffer::framebuffer(ref<mno::texture> const& texture, ref<mno::renderbuffer
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
     glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
                            GL_TEXTURE_2D, texture->buffer(), 0);
-    m_render->bind();
-    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, render->buffer());
+    if (m_render != nullptr) {
+        m_render->bind();
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, render->buffer());
+    }
+    auto const status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    if (status != GL_FRAMEBUFFER_COMPLETE) {
+        glDeleteFramebuffers(1, &m_buffer);
+        throw std::runtime_error("Framebuffer incomplete: " + status_name(status));
+    }
 }
+framebuffer::framebuffer(ref<mno::texture> const& texture) : framebuffer(texture, nullptr) {}
+
 framebuffer::~framebuffer() noexcept {
     glDeleteFramebuffers(1, &m_buffer);
 }
@@ -35,11 +66,21 @@ framebuffer::~framebuffer() noexcept {
 auto framebuffer::resize(std::int32_t const& width, std::int32_t const& height) -> void {
     this->bind();
     m_texture->resize(width, height);
-    m_render->resize(width, height);
+    if (m_render != nullptr) m_render->resize(width, height);
 }
 auto framebuffer::bind() const -> void {
     glBindFramebuffer(GL_FRAMEBUFFER, m_buffer);
 }
 auto framebuffer::unbind() const -> void { glBindFramebuffer(GL_FRAMEBUFFER, 0); }
+
+auto framebuffer::read(mno::image& image) const -> void {
+    image.resize(width(), height(), 4);
+    bind();
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glPixelStorei(GL_PACK_ROW_LENGTH, GLint(image.stride() / 4));
+    glReadPixels(0, 0, width(), height(), GL_RGBA, GL_UNSIGNED_BYTE, image.buffer());
+    glPixelStorei(GL_PACK_ROW_LENGTH, 0);
+    unbind();
+}
 }  // namespace mno
 
@@ -6,49 +6,246 @@
  *
  * @copyright Copyright (c) 2022
  */
-#include <iostream>
 #include "image.hpp"
 
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+
 namespace mno {
-image::image(std::int32_t const& width, std::int32_t const& height, std::int32_t const& channels)
-    : m_width(width), m_height(height), m_channels(channels) {
-    m_buffer = new std::uint8_t[std::size_t(m_width * m_height * m_channels)];
+auto channel_count(pixel_format const& format) -> std::int32_t {
+    switch (format) {
+        case pixel_format::r8:
+        case pixel_format::r16:
+        case pixel_format::r32f:    return 1;
+        case pixel_format::rg8:     return 2;
+        case pixel_format::rgb8:    return 3;
+        case pixel_format::rgba8:
+        case pixel_format::rgba16:
+        case pixel_format::rgba32f:
+        default:                    return 4;
+    }
+}
+
+auto channel_size(pixel_format const& format) -> std::size_t {
+    switch (format) {
+        case pixel_format::r16:
+        case pixel_format::rgba16:  return 2;
+        case pixel_format::r32f:
+        case pixel_format::rgba32f: return 4;
+        default:                    return 1;
+    }
+}
+
+auto pixel_size(pixel_format const& format) -> std::size_t {
+    return std::size_t(channel_count(format)) * channel_size(format);
 }
+
+auto pixel_format_of(std::int32_t const& channels) -> pixel_format {
+    switch (channels) {
+        case 1:  return pixel_format::r8;
+        case 2:  return pixel_format::rg8;
+        case 3:  return pixel_format::rgb8;
+        case 4:  return pixel_format::rgba8;
+        default: throw std::invalid_argument("image: 8-bit formats have 1 to 4 channels");
+    }
+}
+
+auto to_string(pixel_format const& format) -> std::string {
+    switch (format) {
+        case pixel_format::r8:      return "r8";
+        case pixel_format::rg8:     return "rg8";
+        case pixel_format::rgb8:    return "rgb8";
+        case pixel_format::rgba8:   return "rgba8";
+        case pixel_format::r16:     return "r16";
+        case pixel_format::rgba16:  return "rgba16";
+        case pixel_format::r32f:    return "r32f";
+        case pixel_format::rgba32f: return "rgba32f";
+        default:                    return "unknown";
+    }
+}
+
+// Channel conversion to and from 8 bits for the colour accessors.
+static auto store(std::uint8_t* pixel, std::size_t const& size, std::int32_t const& channel,
+                  std::uint8_t const& value) -> void {
+    if (size == 1) {
+        pixel[channel] = value;
+    } else if (size == 2) {
+        auto const v = std::uint16_t(value * 257);
+        std::memcpy(pixel + channel * 2, &v, sizeof(v));
+    } else {
+        auto const v = f32(value) / 255.0f;
+        std::memcpy(pixel + channel * 4, &v, sizeof(v));
+    }
+}
+static auto load(std::uint8_t const* pixel, std::size_t const& size, std::int32_t const& channel) -> std::uint32_t {
+    if (size == 1) return pixel[channel];
+    if (size == 2) {
+        std::uint16_t v;
+        std::memcpy(&v, pixel + channel * 2, sizeof(v));
+        return (std::uint32_t(v) + 128) / 257;
+    }
+    f32 v;
+    std::memcpy(&v, pixel + channel * 4, sizeof(v));
+    return std::uint32_t(std::clamp(v, 0.0f, 1.0f) * 255.0f + 0.5f);
+}
+
+image::image() = default;
+
+image::image(std::int32_t const& width, std::int32_t const& height, std::int32_t const& channels,
+             std::size_t const& row_alignment, std::pmr::memory_resource* resource)
+    : image(width, height, pixel_format_of(channels), row_alignment, resource) {}
+
+image::image(std::int32_t const& width, std::int32_t const& height, pixel_format const& format,
+             std::size_t const& row_alignment, std::pmr::memory_resource* resource)
+    : m_width(width), m_height(height), m_channels(channel_count(format)), m_format(format),
+      m_row_alignment(row_alignment), m_resource(resource) {
+    if (width < 0 || height < 0 || row_alignment == 0 || resource == nullptr)
+        throw std::invalid_argument("image: invalid size, alignment or resource");
+    m_stride = compute_stride();
+    allocate(size());
+}
+
+image::image(image const& other)
+    : m_width(other.m_width), m_height(other.m_height), m_channels(other.m_channels),
+      m_format(other.m_format), m_stride(other.m_stride), m_row_alignment(other.m_row_alignment) {
+    allocate(size());
+    if (size() > 0) std::memcpy(m_buffer, other.m_buffer, size());
+}
+
+image::image(image&& other) noexcept
+    : m_buffer(std::exchange(other.m_buffer, nullptr)),
+      m_width(std::exchange(other.m_width, 0)),
+      m_height(std::exchange(other.m_height, 0)),
+      m_channels(other.m_channels),
+      m_format(other.m_format),
+      m_stride(std::exchange(other.m_stride, 0)),
+      m_row_alignment(other.m_row_alignment),
+      m_capacity(std::exchange(other.m_capacity, 0)),
+      m_resource(other.m_resource) {}
+
 image::~image() {
-    delete[] m_buffer;
+    release();
+}
+
+auto image::operator=(image const& other) -> image& {
+    if (this == &other) return *this;
+    if (other.size() > m_capacity) {
+        // Allocate before touching anything so a failure leaves this image as it was
+        auto* buffer = static_cast<std::uint8_t*>(m_resource->allocate(other.size(), alignment));
+        release();
+        m_buffer   = buffer;
+        m_capacity = other.size();
+    }
+    m_width         = other.m_width;
+    m_height        = other.m_height;
+    m_channels      = other.m_channels;
+    m_format        = other.m_format;
+    m_stride        = other.m_stride;
+    m_row_alignment = other.m_row_alignment;
+    if (size() > 0) std::memcpy(m_buffer, other.m_buffer, size());
+    return *this;
+}
+
+auto image::operator=(image&& other) noexcept -> image& {
+    if (this == &other) return *this;
+    release();
+    m_buffer        = std::exchange(other.m_buffer, nullptr);
+    m_width         = std::exchange(other.m_width, 0);
+    m_height        = std::exchange(other.m_height, 0);
+    m_channels      = other.m_channels;
+    m_format        = other.m_format;
+    m_stride        = std::exchange(other.m_stride, 0);
+    m_row_alignment = other.m_row_alignment;
+    m_capacity      = std::exchange(other.m_capacity, 0);
+    // The block goes back to the resource it came from
+    m_resource      = other.m_resource;
+    return *this;
 }
 
 auto image::resize(std::int32_t const& width, std::int32_t const& height,
                    std::int32_t const& channels) -> void {
-    if (m_width == width && m_height == height && m_channels == channels) return;
+    resize(width, height, pixel_format_of(channels));
+}
+
+auto image::resize(std::int32_t const& width, std::int32_t const& height, pixel_format const& format) -> void {
+    if (m_width == width && m_height == height && m_format == format) return;
+    if (width < 0 || height < 0) throw std::invalid_argument("image: invalid size");
+    reshape(width, height, format);
+}
+
+auto image::reshape(std::int32_t const& width, std::int32_t const& height, pixel_format const& format) -> void {
     m_width    = width;
     m_height   = height;
-    m_channels = channels;
-    delete[] m_buffer;
-    m_buffer = new std::uint8_t[std::size_t(m_width * m_height * m_channels)];
+    m_format   = format;
+    m_channels = channel_count(format);
+    m_stride   = compute_stride();
+    if (size() > m_capacity) {
+        release();
+        allocate(size());
+    }
+}
+
+auto image::compute_stride() const -> std::size_t {
+    // Multiple of both so every row starts aligned and on a whole pixel
+    auto const step = std::lcm(m_row_alignment, pixel_size());
+    auto const row  = std::size_t(m_width) * pixel_size();
+    return (row + step - 1) / step * step;
+}
+
+auto image::allocate(std::size_t const& size) -> void {
+    if (size == 0) return;
+    m_buffer   = static_cast<std::uint8_t*>(m_resource->allocate(size, alignment));
+    m_capacity = size;
+}
+
+auto image::release() -> void {
+    if (m_buffer != nullptr) m_resource->deallocate(m_buffer, m_capacity, alignment);
+    m_buffer   = nullptr;
+    m_capacity = 0;
 }
 
 auto image::get(std::int32_t const& x, std::int32_t const& y) const -> std::uint32_t {
-    auto const index = (y * m_channels) * m_width + (x * m_channels);
-    return std::uint32_t(m_buffer[index + 0]) << 16 |
-           std::uint32_t(m_buffer[index + 1]) <<  8 |
-           std::uint32_t(m_buffer[index + 2]) <<  0;
+    auto const* p = pixel<std::uint8_t>(x, y);
+    auto const size = channel_size(m_format);
+    std::uint32_t color = 0;
+    for (std::int32_t c = 0; c < std::min(m_channels, 3); c++)
+        color |= load(p, size, c) << (16 - 8 * c);
+    return color;
 }
 auto image::set(std::int32_t const& x, std::int32_t const& y, std::uint32_t const& color, std::uint8_t const& alpha) -> void {
-    auto const index = (y * m_channels) * m_width + (x * m_channels);
-    m_buffer[index + 0] = (color >> 16) & 0xFF;
-    m_buffer[index + 1] = (color >>  8) & 0xFF;
-    m_buffer[index + 2] = (color >>  0) & 0xFF;
-    m_buffer[index + 3] = alpha;
+    set(x, y, std::uint8_t(color >> 16), std::uint8_t(color >> 8), std::uint8_t(color), alpha);
 }
 auto image::set(std::int32_t const& x, std::int32_t const& y,
                 std::uint8_t const& red,  std::uint8_t const& green,
                 std::uint8_t const& blue, std::uint8_t const& alpha) -> void {
-    auto const index = y * m_channels * m_width + (x * m_channels);
-    m_buffer[index + 0] = red;
-    m_buffer[index + 1] = green;
-    m_buffer[index + 2] = blue;
-    m_buffer[index + 3] = alpha;
+    auto* p = pixel<std::uint8_t>(x, y);
+    if (m_format == pixel_format::rgba8) {
+        p[0] = red;
+        p[1] = green;
+        p[2] = blue;
+        p[3] = alpha;
+        return;
+    }
+    std::uint8_t const values[]{red, green, blue, alpha};
+    auto const size = channel_size(m_format);
+    for (std::int32_t c = 0; c < m_channels; c++) store(p, size, c, values[c]);
+}
+auto image::fill(std::uint32_t const& color, std::uint8_t const& alpha) -> void {
+    fill(0, 0, m_width, m_height, color, alpha);
+}
+auto image::fill(std::int32_t const& x0, std::int32_t const& y0, std::int32_t const& x1, std::int32_t const& y1,
+                 std::uint32_t const& color, std::uint8_t const& alpha) -> void {
+    if (x0 >= x1 || y0 >= y1) return;
+    // Convert once into the first pixel, double it across the first row and
+    // copy that row into the rest.
+    set(x0, y0, color, alpha);
+    auto* first = pixel<std::uint8_t>(x0, y0);
+    auto const row_size = std::size_t(x1 - x0) * pixel_size();
+    for (auto filled = pixel_size(); filled < row_size; filled *= 2)
+        std::memcpy(first + filled, first, std::min(filled, row_size - filled));
+    for (auto y = y0 + 1; y < y1; y++) std::memcpy(pixel<std::uint8_t>(x0, y), first, row_size);
 }
 }  // namespace mno
-
@@ -0,0 +1,235 @@
+/**
+ * @file   profiler.cpp
+ * @author Pratchaya Khansomboon (me@mononerv.dev)
+ * @brief  Per-pass CPU and GPU frame profiler with Chrome trace output.
+ * @date   2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ */
+#include "profiler.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+#include "glad/glad.h"
+
+namespace mno {
+static constexpr f64 not_measured = std::numeric_limits<f64>::quiet_NaN();
+
+auto json_escape(std::string_view const& str) -> std::string {
+    std::string out;
+    for (auto const c : str) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if (std::uint8_t(c) < 0x20) {
+            char escape[8];
+            std::snprintf(escape, sizeof(escape), "\\u%04x", std::uint32_t(std::uint8_t(c)));
+            out += escape;
+        } else {
+            out += c;
+        }
+    }
+    return out;
+}
+
+// Complete event on one of the two tracks, times in milliseconds.
+static auto trace_event(std::ostringstream& out, std::string_view const& name, char const* category,
+                        std::int32_t const& track, f64 const& start_ms, f64 const& duration_ms) -> void {
+    out << ",\n{\"name\":\"" << json_escape(name) << "\",\"cat\":\"" << category
+        << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << track
+        << ",\"ts\":" << start_ms * 1e3 << ",\"dur\":" << duration_ms * 1e3 << "}";
+}
+
+profiler::profiler(std::size_t const& depth, std::size_t const& max_passes)
+    : m_start(std::chrono::steady_clock::now()), m_slots(std::max(depth, std::size_t(1))) {
+    for (auto& s : m_slots) {
+        s.queries.resize(max_passes);
+        s.query_pass.resize(max_passes);
+        if (max_passes > 0) glGenQueries(GLsizei(max_passes), s.queries.data());
+        glGenQueries(1, &s.timestamp);
+        s.timing.passes.reserve(max_passes);
+    }
+    m_cpu_frame.passes.reserve(max_passes);
+    m_latest.passes.reserve(max_passes);
+    m_open.reserve(16);
+
+    // Both clocks now, GPU timestamps become CPU times by adding the offset
+    GLint64 gpu_now = 0;
+    glGetInteger64v(GL_TIMESTAMP, &gpu_now);
+    m_gpu_offset_ms = now_ms() - f64(gpu_now) * 1e-6;
+}
+
+profiler::~profiler() {
+    for (auto& s : m_slots) {
+        if (!s.queries.empty()) glDeleteQueries(GLsizei(s.queries.size()), s.queries.data());
+        glDeleteQueries(1, &s.timestamp);
+    }
+}
+
+auto profiler::begin_frame() -> void {
+    if (m_in_frame) end_frame();
+    collect();
+    m_slot = std::size_t(m_frame % m_slots.size());
+    auto& s = m_slots[m_slot];
+    m_use_slot = !s.pending;
+    if (!m_use_slot) m_cpu_only_frames++;
+
+    auto& timing = current();
+    timing.frame        = m_frame;
+    timing.cpu_start_ms = now_ms();
+    timing.cpu_ms       = 0.0;
+    timing.gpu_start_ms = 0.0;
+    timing.gpu_ms       = 0.0;
+    timing.has_gpu      = m_use_slot;
+    timing.passes.clear();
+    if (m_use_slot) {
+        s.used = 0;
+        glQueryCounter(s.timestamp, GL_TIMESTAMP);
+    }
+    m_in_frame = true;
+}
+
+auto profiler::end_frame() -> void {
+    if (!m_in_frame) return;
+    while (!m_open.empty()) end_pass();
+    auto& timing = current();
+    timing.cpu_ms = now_ms() - timing.cpu_start_ms;
+    if (m_use_slot) m_slots[m_slot].pending = true;
+    else publish(timing);
+    m_in_frame = false;
+    m_frame++;
+}
+
+auto profiler::begin_pass(std::string_view const& name) -> void {
+    if (!m_in_frame) return;
+    auto& timing = current();
+    auto const depth = std::uint32_t(m_open.size());
+    auto const index = timing.passes.size();
+    timing.passes.push_back({intern(name), depth, now_ms(), 0.0, not_measured});
+
+    auto is_timed = false;
+    if (m_use_slot && depth == 0) {
+        auto& s = m_slots[m_slot];
+        if (s.used < s.queries.size()) {
+            s.query_pass[s.used] = index;
+            glBeginQuery(GL_TIME_ELAPSED, s.queries[s.used++]);
+            is_timed = true;
+        }
+    }
+    m_open.emplace_back(index, is_timed);
+}
+
+auto profiler::end_pass() -> void {
+    if (m_open.empty()) return;
+    auto const [index, is_timed] = m_open.back();
+    m_open.pop_back();
+    auto& pass = current().passes[index];
+    pass.cpu_ms = now_ms() - pass.cpu_start_ms;
+    if (is_timed) glEndQuery(GL_TIME_ELAPSED);
+}
+
+auto profiler::collect() -> void {
+    // Slots in frame order, the one about to be reused holds the oldest frame
+    for (std::size_t k = 0; k < m_slots.size(); k++) {
+        auto& s = m_slots[std::size_t((m_frame + k) % m_slots.size())];
+        if (!s.pending) continue;
+        // Queries finish in order, the last one being ready means all are
+        auto const last = s.used > 0 ? s.queries[s.used - 1] : s.timestamp;
+        GLint available = 0;
+        glGetQueryObjectiv(last, GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available) break;
+
+        GLuint64 value = 0;
+        glGetQueryObjectui64v(s.timestamp, GL_QUERY_RESULT, &value);
+        s.timing.gpu_start_ms = f64(value) * 1e-6 + m_gpu_offset_ms;
+        for (std::size_t i = 0; i < s.used; i++) {
+            glGetQueryObjectui64v(s.queries[i], GL_QUERY_RESULT, &value);
+            s.timing.passes[s.query_pass[i]].gpu_ms = f64(value) * 1e-6;
+            s.timing.gpu_ms += f64(value) * 1e-6;
+        }
+        s.pending = false;
+        publish(s.timing);
+    }
+}
+
+auto profiler::publish(frame_timing const& timing) -> void {
+    if (timing.has_gpu) m_latest = timing;
+    if (!m_tracing) return;
+    m_trace.push_back(timing);
+    while (m_trace.size() > m_trace_capacity) m_trace.pop_front();
+}
+
+auto profiler::start_trace(std::size_t const& max_frames) -> void {
+    m_trace.clear();
+    m_trace_capacity = std::max(max_frames, std::size_t(1));
+    m_tracing = true;
+}
+
+auto profiler::trace_json() const -> std::string {
+    // CPU only frames are published before older GPU frames resolve
+    std::vector<frame_timing const*> frames;
+    for (auto const& timing : m_trace) frames.push_back(&timing);
+    std::sort(std::begin(frames), std::end(frames), [](auto const* a, auto const* b) { return a->frame < b->frame; });
+
+    std::ostringstream out;
+    out.setf(std::ios::fixed);
+    out.precision(3);
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n"
+        << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"mno::profiler\"}},\n"
+        << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"CPU\"}},\n"
+        << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":2,\"args\":{\"name\":\"GPU\"}}";
+    for (auto const* timing : frames) {
+        auto const name = "frame " + std::to_string(timing->frame);
+        trace_event(out, name, "frame", 1, timing->cpu_start_ms, timing->cpu_ms);
+        for (auto const& pass : timing->passes)
+            trace_event(out, pass.name, "cpu", 1, pass.cpu_start_ms, pass.cpu_ms);
+        if (!timing->has_gpu) continue;
+        trace_event(out, name, "frame", 2, timing->gpu_start_ms, timing->gpu_ms);
+        auto cursor = timing->gpu_start_ms;
+        for (auto const& pass : timing->passes) {
+            if (std::isnan(pass.gpu_ms)) continue;
+            trace_event(out, pass.name, "gpu", 2, cursor, pass.gpu_ms);
+            cursor += pass.gpu_ms;
+        }
+    }
+    out << "\n]}\n";
+    return out.str();
+}
+
+auto profiler::write_trace(std::filesystem::path const& path) const -> void {
+    std::ofstream output{path, std::ios::out | std::ios::binary};
+    if (!output.is_open() || output.fail())
+        throw std::runtime_error("ERROR: Writing trace " + path.string());
+    output << trace_json();
+}
+
+auto profiler::now_ms() const -> f64 {
+    return std::chrono::duration<f64, std::milli>(std::chrono::steady_clock::now() - m_start).count();
+}
+
+auto profiler::intern(std::string_view const& name) -> std::string_view {
+    for (auto const& str : m_names)
+        if (str == name) return str;
+    return m_names.emplace_back(name);
+}
+
+auto profiler::current() -> frame_timing& {
+    return m_use_slot ? m_slots[m_slot].timing : m_cpu_frame;
+}
+
+auto profiler::str() const -> std::string {
+    std::string str{"mno::profiler { "};
+    str += "depth: " + std::to_string(m_slots.size()) + ", ";
+    str += "frame: " + std::to_string(m_frame) + ", ";
+    str += "cpu_only: " + std::to_string(m_cpu_only_frames) + ", ";
+    str += "latest: [cpu: " + std::to_string(m_latest.cpu_ms) + " ms, ";
+    str += "gpu: " + std::to_string(m_latest.gpu_ms) + " ms] }";
+    return str;
+}
+}  // namespace mno
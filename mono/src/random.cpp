@@ -0,0 +1,224 @@
+/**
+ * @file   random.cpp
+ * @author Pratchaya Khansomboon (me@mononerv.dev)
+ * @brief  Counter-based random numbers for parallel fills.
+ * @date   2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ */
+#include "random.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define MONO_X86 1
+#include <immintrin.h>
+#endif
+
+#if defined(MONO_X86) && (defined(__GNUC__) || defined(__clang__))
+#define MONO_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define MONO_TARGET_AVX2
+#endif
+
+namespace mno {
+// Multipliers and Weyl key increments from Salmon et al., "Parallel random
+// numbers: as easy as 1, 2, 3", SC 2011.
+static constexpr std::uint32_t philox_m0 = 0xD2511F53;
+static constexpr std::uint32_t philox_m1 = 0xCD9E8D57;
+static constexpr std::uint32_t philox_w0 = 0x9E3779B9;
+static constexpr std::uint32_t philox_w1 = 0xBB67AE85;
+static constexpr std::int32_t  philox_rounds = 10;
+// Values per chunk of the fills, small enough to stay on the stack
+static constexpr std::size_t   chunk_size = 256;
+
+auto philox(std::uint64_t const& seed, std::uint64_t const& counter) -> std::array<std::uint32_t, 4> {
+    return philox({std::uint32_t(counter), std::uint32_t(counter >> 32), 0, 0},
+                  {std::uint32_t(seed), std::uint32_t(seed >> 32)});
+}
+
+auto philox(std::array<std::uint32_t, 4> const& counter, std::array<std::uint32_t, 2> const& key)
+    -> std::array<std::uint32_t, 4> {
+    auto [c0, c1, c2, c3] = counter;
+    auto [k0, k1] = key;
+    for (std::int32_t r = 0; r < philox_rounds; r++) {
+        auto const p0 = std::uint64_t(philox_m0) * c0;
+        auto const p1 = std::uint64_t(philox_m1) * c2;
+        c0 = std::uint32_t(p1 >> 32) ^ c1 ^ k0;
+        c2 = std::uint32_t(p0 >> 32) ^ c3 ^ k1;
+        c1 = std::uint32_t(p1);
+        c3 = std::uint32_t(p0);
+        k0 += philox_w0;
+        k1 += philox_w1;
+    }
+    return {c0, c1, c2, c3};
+}
+
+static auto random_scalar(std::uint64_t seed, std::uint64_t first, std::uint32_t* out, std::size_t count) -> void {
+    for (std::size_t i = 0; i < count;) {
+        auto const block = philox(seed, (first + i) / 4);
+        for (auto w = (first + i) % 4; w < 4 && i < count; w++, i++) out[i] = block[w];
+    }
+}
+
+#ifdef MONO_X86
+// High halves of the eight 32x32 products, mul_epu32 only multiplies the
+// even lanes so the odd lanes are shifted down and done separately.
+MONO_TARGET_AVX2
+static inline auto mulhi_avx2(__m256i const& a, __m256i const& b) -> __m256i {
+    auto const even = _mm256_srli_epi64(_mm256_mul_epu32(a, b), 32);
+    auto const odd  = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(b, 32));
+    return _mm256_blend_epi32(even, odd, 0xAA);
+}
+
+// Eight blocks at once, lane i of c0..c3 is word 0..3 of counter + i.
+MONO_TARGET_AVX2
+static auto philox_avx2(std::uint64_t const& seed, std::uint64_t const& counter, std::uint32_t* out) -> void {
+    auto const m0 = _mm256_set1_epi32(std::int32_t(philox_m0));
+    auto const m1 = _mm256_set1_epi32(std::int32_t(philox_m1));
+    auto c0 = _mm256_add_epi32(_mm256_set1_epi32(std::int32_t(std::uint32_t(counter))),
+                               _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+    auto c1 = _mm256_set1_epi32(std::int32_t(std::uint32_t(counter >> 32)));
+    auto c2 = _mm256_setzero_si256();
+    auto c3 = _mm256_setzero_si256();
+    auto k0 = std::uint32_t(seed), k1 = std::uint32_t(seed >> 32);
+    for (std::int32_t r = 0; r < philox_rounds; r++) {
+        auto const hi0 = mulhi_avx2(m0, c0);
+        auto const lo0 = _mm256_mullo_epi32(m0, c0);
+        auto const hi1 = mulhi_avx2(m1, c2);
+        auto const lo1 = _mm256_mullo_epi32(m1, c2);
+        c0 = _mm256_xor_si256(_mm256_xor_si256(hi1, c1), _mm256_set1_epi32(std::int32_t(k0)));
+        c2 = _mm256_xor_si256(_mm256_xor_si256(hi0, c3), _mm256_set1_epi32(std::int32_t(k1)));
+        c1 = lo1;
+        c3 = lo0;
+        k0 += philox_w0;
+        k1 += philox_w1;
+    }
+    // Transpose so the words of each block are stored next to each other
+    auto const t0 = _mm256_unpacklo_epi32(c0, c1);
+    auto const t1 = _mm256_unpackhi_epi32(c0, c1);
+    auto const t2 = _mm256_unpacklo_epi32(c2, c3);
+    auto const t3 = _mm256_unpackhi_epi32(c2, c3);
+    auto const u0 = _mm256_unpacklo_epi64(t0, t2);
+    auto const u1 = _mm256_unpackhi_epi64(t0, t2);
+    auto const u2 = _mm256_unpacklo_epi64(t1, t3);
+    auto const u3 = _mm256_unpackhi_epi64(t1, t3);
+    auto* dst = reinterpret_cast<__m256i*>(out);
+    _mm256_storeu_si256(dst + 0, _mm256_permute2x128_si256(u0, u1, 0x20));
+    _mm256_storeu_si256(dst + 1, _mm256_permute2x128_si256(u2, u3, 0x20));
+    _mm256_storeu_si256(dst + 2, _mm256_permute2x128_si256(u0, u1, 0x31));
+    _mm256_storeu_si256(dst + 3, _mm256_permute2x128_si256(u2, u3, 0x31));
+}
+
+MONO_TARGET_AVX2
+static auto random_avx2(std::uint64_t seed, std::uint64_t first, std::uint32_t* out, std::size_t count) -> void {
+    // Scalar up to a block boundary, then 32 values per batch
+    auto const head = std::min(count, std::size_t((4 - first % 4) % 4));
+    random_scalar(seed, first, out, head);
+    auto i = head;
+    for (; i + 32 <= count; i += 32) {
+        auto const counter = (first + i) / 4;
+        // The lanes only add to the low word, let blocks that carry into the high word go scalar
+        if (std::uint32_t(counter) > 0xFFFFFFFF - 7) random_scalar(seed, first + i, out + i, 32);
+        else philox_avx2(seed, counter, out + i);
+    }
+    random_scalar(seed, first + i, out + i, count - i);
+}
+#endif
+
+auto random_kernel_for(simd_level const& level) -> random_kernel {
+#ifdef MONO_X86
+    if (level >= simd_level::avx2) return random_avx2;
+#else
+    (void)level;
+#endif
+    return random_scalar;
+}
+
+auto random_u32(std::uint64_t const& seed, std::uint64_t const& first, std::uint32_t* out,
+                std::size_t const& count) -> void {
+    random_kernel_for(cpu_simd_level())(seed, first, out, count);
+}
+
+auto random_threshold(f32 const& density) -> std::uint32_t {
+    return std::uint32_t(std::clamp(std::round(f64(density) * 16777216.0), 0.0, 16777216.0));
+}
+
+auto random_fill(image& image, std::uint64_t const& seed, f32 const& density) -> void {
+    random_fill(image, seed, density, 0, 0, image.width(), image.height());
+}
+
+auto random_fill(image& image, std::uint64_t const& seed, f32 const& density, tile_scheduler& scheduler) -> void {
+    scheduler.run(image, [&](tile const& t) {
+        random_fill(image, seed, density, t.x0, t.y0, t.x1, t.y1);
+    });
+}
+
+auto random_fill(image& image, std::uint64_t const& seed, f32 const& density,
+                 std::int32_t const& x0, std::int32_t const& y0, std::int32_t const& x1, std::int32_t const& y1) -> void {
+    auto const kernel    = random_kernel_for(cpu_simd_level());
+    auto const threshold = random_threshold(density);
+    auto const channels  = image.channels();
+    auto const is_8bit   = channel_size(image.format()) == 1;
+    std::uint32_t values[chunk_size];
+    for (auto y = y0; y < y1; y++) {
+        for (auto x = x0; x < x1; x += std::int32_t(chunk_size)) {
+            auto const count = std::min(std::size_t(x1 - x), chunk_size);
+            kernel(seed, std::uint64_t(y) * std::uint64_t(image.width()) + std::uint64_t(x), values, count);
+            if (!is_8bit) {
+                for (std::size_t i = 0; i < count; i++)
+                    image.set(x + std::int32_t(i), y, (values[i] >> 8) < threshold ? 0xFFFFFF : 0x000000);
+                continue;
+            }
+            // Colour channels take the value, alpha stays opaque
+            auto row = image.row<std::uint8_t>(y, x, x + std::int32_t(count));
+            for (std::size_t i = 0; i < count; i++) {
+                auto const value = std::uint8_t((values[i] >> 8) < threshold ? 255 : 0);
+                for (std::int32_t c = 0; c < channels; c++)
+                    row[i * std::size_t(channels) + std::size_t(c)] = c == 3 ? 255 : value;
+            }
+        }
+    }
+}
+
+auto random_bits(std::uint64_t const& seed, std::uint64_t const& first, std::uint64_t* out,
+                 std::size_t const& count, f32 const& density) -> void {
+    auto const level = std::uint32_t(std::clamp(std::round(f64(density) * 65536.0), 0.0, 65536.0));
+    if (level == 0 || level == 65536) {
+        std::fill(out, out + count, level == 0 ? 0 : ~std::uint64_t(0));
+        return;
+    }
+    // A cell is set when its 16-bit number u is below level. Planes go from
+    // the most significant bit down, less holds the cells already known to
+    // be below and equal the ones that match level so far.
+    auto const kernel = random_kernel_for(cpu_simd_level());
+    auto const planes = 16 - std::countr_zero(level);
+    std::uint32_t values[chunk_size];
+    std::uint64_t equal[chunk_size / 4];
+    for (std::size_t offset = 0; offset < count; offset += chunk_size / 4) {
+        auto const words = std::min(count - offset, chunk_size / 4);
+        auto* less = out + offset;
+        std::fill(less, less + words, 0);
+        std::fill(equal, equal + words, ~std::uint64_t(0));
+        for (std::int32_t b = 0; b < planes; b++) {
+            if (b % 2 == 0) {
+                auto const block = (std::uint64_t(b / 2) << 40) + first + offset;
+                kernel(seed, block * 4, values, words * 4);
+            }
+            auto const is_set = (level >> (15 - b)) & 1;
+            for (std::size_t i = 0; i < words; i++) {
+                auto const* v = values + i * 4 + std::size_t(b % 2) * 2;
+                auto const plane = std::uint64_t(v[0]) | std::uint64_t(v[1]) << 32;
+                if (is_set) {
+                    less[i] |= equal[i] & ~plane;
+                    equal[i] &= plane;
+                } else {
+                    equal[i] &= ~plane;
+                }
+            }
+        }
+    }
+}
+}  // namespace mno
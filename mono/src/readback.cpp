@@ -0,0 +1,129 @@
+/**
+ * @file   readback.cpp
+ * @author Pratchaya Khansomboon (me@mononerv.dev)
+ * @brief  Asynchronous framebuffer readback through a ring of pixel buffers.
+ * @date   2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ */
+#include "readback.hpp"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#include "glad/glad.h"
+#include "spdlog/spdlog.h"
+
+namespace mno {
+readback::readback(std::int32_t const& width, std::int32_t const& height, std::size_t const& depth)
+    : m_width(width), m_height(height), m_slots(std::max(depth, std::size_t(1))) {
+    allocate();
+}
+readback::~readback() noexcept {
+    release();
+}
+
+auto readback::capture(mno::framebuffer const& framebuffer) -> bool {
+    if (framebuffer.width() != m_width || framebuffer.height() != m_height)
+        throw std::invalid_argument("readback: framebuffer size does not match the buffers");
+    if (m_count == m_slots.size()) return false;
+    auto& s = m_slots[(m_head + m_count) % m_slots.size()];
+
+    framebuffer.bind();
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, s.buffer);
+    glReadPixels(0, 0, m_width, m_height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    framebuffer.unbind();
+
+    s.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    glFlush();  // make sure the fence reaches the GPU so polling can see it
+    s.frame = m_captured++;
+    m_count++;
+    return true;
+}
+
+auto readback::fetch(mno::image& image, bool const& wait) -> bool {
+    if (m_count == 0) return false;
+    auto& s = m_slots[m_head];
+
+    auto const fence = static_cast<GLsync>(s.fence);
+    auto status = glClientWaitSync(fence, 0, 0);
+    while (wait && status == GL_TIMEOUT_EXPIRED)
+        status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1'000'000'000);
+    if (status == GL_TIMEOUT_EXPIRED) return false;
+    glDeleteSync(fence);
+    s.fence = nullptr;
+    if (status == GL_WAIT_FAILED) {
+        // The fence will never signal, skip the frame so the ones behind it can be fetched
+        spdlog::warn("READBACK::WAIT failed for frame {}: 0x{:04X}", s.frame, glGetError());
+        m_dropped++;
+        m_head = (m_head + 1) % m_slots.size();
+        m_count--;
+        return false;
+    }
+
+    auto const size = std::size_t(m_width) * std::size_t(m_height) * 4;
+    image.resize(m_width, m_height, 4);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, s.buffer);
+    auto const* pixels = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, GLsizeiptr(size), GL_MAP_READ_BIT);
+    if (pixels != nullptr) {
+        auto const row_size = std::size_t(m_width) * 4;
+        if (image.stride() == row_size) {
+            std::memcpy(image.buffer(), pixels, size);
+        } else {
+            auto const* src = static_cast<std::uint8_t const*>(pixels);
+            for (std::int32_t y = 0; y < m_height; y++, src += row_size)
+                std::memcpy(image.buffer() + std::size_t(y) * image.stride(), src, row_size);
+        }
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    } else {
+        spdlog::warn("READBACK::MAP failed for frame {}: 0x{:04X}", s.frame, glGetError());
+        m_dropped++;
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    m_frame = s.frame;
+    m_head  = (m_head + 1) % m_slots.size();
+    m_count--;
+    return pixels != nullptr;
+}
+
+auto readback::resize(std::int32_t const& width, std::int32_t const& height) -> void {
+    release();
+    m_width  = width;
+    m_height = height;
+    allocate();
+}
+
+auto readback::allocate() -> void {
+    auto const size = GLsizeiptr(m_width) * GLsizeiptr(m_height) * 4;
+    for (auto& s : m_slots) {
+        glGenBuffers(1, &s.buffer);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, s.buffer);
+        glBufferData(GL_PIXEL_PACK_BUFFER, size, nullptr, GL_STREAM_READ);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    m_head  = 0;
+    m_count = 0;
+}
+
+auto readback::release() -> void {
+    for (auto& s : m_slots) {
+        if (s.fence != nullptr) glDeleteSync(static_cast<GLsync>(s.fence));
+        glDeleteBuffers(1, &s.buffer);
+        s = slot{};
+    }
+    m_count = 0;
+}
+
+auto readback::str() const -> std::string {
+    std::string str{"mno::readback { "};
+    str += "width: "   + std::to_string(m_width) + ", ";
+    str += "height: "  + std::to_string(m_height) + ", ";
+    str += "depth: "   + std::to_string(m_slots.size()) + ", ";
+    str += "pending: " + std::to_string(m_count) + ", ";
+    str += "dropped: " + std::to_string(m_dropped) + " }";
+    return str;
+}
+}  // namespace mno
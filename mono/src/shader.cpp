@@ -7,6 +7,12 @@
  * @copyright Copyright (c) 2022
  */
 #include "shader.hpp"
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <system_error>
+#include <vector>
 
 #include "spdlog/spdlog.h"
 #include "glad/glad.h"
@@ -44,11 +50,35 @@ auto shader::make(std::string const& vertex_source, std::string const& fragment_
 auto shader::make() -> local<shader> {
     return make_local<shader>(basic_vertex_shader, basic_fragment_shader);
 }
+auto shader::load(std::filesystem::path const& vertex_file, std::filesystem::path const& fragment_file) -> local<shader> {
+    auto const read = [](std::filesystem::path const& file) -> std::string {
+        std::ifstream input{file, std::ios::in};
+        if (!input.is_open() || input.fail())
+            throw std::runtime_error("ERROR: Loading shader source " + file.string());
+        return {std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>()};
+    };
+    return make(read(vertex_file), read(fragment_file));
+}
+
+static std::filesystem::path s_cache_directory{};
+
+auto shader::set_cache_directory(std::filesystem::path const& directory) -> void {
+    s_cache_directory = directory;
+}
+auto shader::cache_directory() -> std::filesystem::path const& {
+    return s_cache_directory;
+}
 
 shader::shader(std::string const& vertex_source, std::string const& fragment_source) {
-    auto vs = shader::compile(GL_VERTEX_SHADER,   vertex_source.c_str());
-    auto fs = shader::compile(GL_FRAGMENT_SHADER, fragment_source.c_str());
-    m_id    = shader::link(vs, fs);
+    auto const path = cache_path(vertex_source, fragment_source);
+    m_id = path.empty() ? 0 : load_binary(path);
+    if (m_id == 0) {
+        auto vs = shader::compile(GL_VERTEX_SHADER,   vertex_source.c_str());
+        auto fs = shader::compile(GL_FRAGMENT_SHADER, fragment_source.c_str());
+        m_id    = shader::link(vs, fs);
+        if (!path.empty()) save_binary(m_id, path);
+    }
+    reflect();
 }
 shader::~shader() {
     glDeleteProgram(m_id);
@@ -57,42 +87,78 @@ shader::~shader() {
 auto shader::bind() const -> void { glUseProgram(m_id); }
 auto shader::unbind() const -> void { glUseProgram(0); }
 
-auto shader::num(std::string const& name, mno::u32 const& value) -> void {
+auto shader::num(std::string_view const& name, mno::u32 const& value) -> void {
     glUniform1ui(uniform_location(name), value);
 }
-auto shader::num(std::string const& name, mno::i32 const& value) -> void {
+auto shader::num(std::string_view const& name, mno::i32 const& value) -> void {
     glUniform1i(uniform_location(name), value);
 }
-auto shader::num(std::string const& name, mno::f32 const& value) -> void {
+auto shader::num(std::string_view const& name, mno::f32 const& value) -> void {
     glUniform1f(uniform_location(name), value);
 }
-auto shader::num(std::string const& name, mno::i32 const& count, float const* value) -> void {
+auto shader::num(std::string_view const& name, mno::i32 const& count, float const* value) -> void {
     glUniform1fv(uniform_location(name), count, value);
 }
 
-auto shader::vec2(std::string const& name, glm::vec2 const& value) -> void {
+auto shader::vec2(std::string_view const& name, glm::vec2 const& value) -> void {
     glUniform2fv(uniform_location(name), 1, glm::value_ptr(value));
 }
-auto shader::vec3(std::string const& name, glm::vec3 const& value) -> void {
+auto shader::vec3(std::string_view const& name, glm::vec3 const& value) -> void {
     glUniform3fv(uniform_location(name), 1, glm::value_ptr(value));
 }
-auto shader::vec4(std::string const& name, glm::vec3 const& value) -> void {
+auto shader::vec4(std::string_view const& name, glm::vec4 const& value) -> void {
     glUniform4fv(uniform_location(name), 1, glm::value_ptr(value));
 }
 
-auto shader::mat2(std::string const& name, glm::mat2 const& value, bool const& transpose) -> void {
+auto shader::mat2(std::string_view const& name, glm::mat2 const& value, bool const& transpose) -> void {
     glUniformMatrix2fv(uniform_location(name), 1, (transpose ? GL_TRUE : GL_FALSE),
                        glm::value_ptr(value));
 }
-auto shader::mat3(std::string const& name, glm::mat3 const& value, bool const& transpose) -> void {
+auto shader::mat3(std::string_view const& name, glm::mat3 const& value, bool const& transpose) -> void {
     glUniformMatrix3fv(uniform_location(name), 1, (transpose ? GL_TRUE : GL_FALSE),
                        glm::value_ptr(value));
 }
-auto shader::mat4(std::string const& name, glm::mat4 const& value, bool const& transpose) -> void {
+auto shader::mat4(std::string_view const& name, glm::mat4 const& value, bool const& transpose) -> void {
     glUniformMatrix4fv(uniform_location(name), 1, (transpose ? GL_TRUE : GL_FALSE),
                        glm::value_ptr(value));
 }
 
+auto shader::bind_block(std::string_view const& name, mno::u32 const& binding) -> bool {
+    std::string const block{name};
+    auto const index = glGetUniformBlockIndex(m_id, block.c_str());
+    if (index == GL_INVALID_INDEX) return false;
+    glUniformBlockBinding(m_id, index, binding);
+    return true;
+}
+
+auto shader::set(uniform_handle<mno::u32> const& uniform, mno::u32 const& value) -> void {
+    glUniform1ui(uniform.location, value);
+}
+auto shader::set(uniform_handle<mno::i32> const& uniform, mno::i32 const& value) -> void {
+    glUniform1i(uniform.location, value);
+}
+auto shader::set(uniform_handle<mno::f32> const& uniform, mno::f32 const& value) -> void {
+    glUniform1f(uniform.location, value);
+}
+auto shader::set(uniform_handle<glm::vec2> const& uniform, glm::vec2 const& value) -> void {
+    glUniform2fv(uniform.location, 1, glm::value_ptr(value));
+}
+auto shader::set(uniform_handle<glm::vec3> const& uniform, glm::vec3 const& value) -> void {
+    glUniform3fv(uniform.location, 1, glm::value_ptr(value));
+}
+auto shader::set(uniform_handle<glm::vec4> const& uniform, glm::vec4 const& value) -> void {
+    glUniform4fv(uniform.location, 1, glm::value_ptr(value));
+}
+auto shader::set(uniform_handle<glm::mat2> const& uniform, glm::mat2 const& value, bool const& transpose) -> void {
+    glUniformMatrix2fv(uniform.location, 1, (transpose ? GL_TRUE : GL_FALSE), glm::value_ptr(value));
+}
+auto shader::set(uniform_handle<glm::mat3> const& uniform, glm::mat3 const& value, bool const& transpose) -> void {
+    glUniformMatrix3fv(uniform.location, 1, (transpose ? GL_TRUE : GL_FALSE), glm::value_ptr(value));
+}
+auto shader::set(uniform_handle<glm::mat4> const& uniform, glm::mat4 const& value, bool const& transpose) -> void {
+    glUniformMatrix4fv(uniform.location, 1, (transpose ? GL_TRUE : GL_FALSE), glm::value_ptr(value));
+}
+
 auto shader::str() const -> std::string {
     std::string str{"mno::shader { "};
     str += "id: " + std::to_string(m_id);
@@ -121,6 +187,7 @@ auto shader::compile(mno::u32 const& type, char const* source) -> mno::u32 {
 }
 auto shader::link(mno::u32 const& fs, mno::u32 const& vs) -> mno::u32 {
     mno::u32 program = glCreateProgram();
+    if (!s_cache_directory.empty()) glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
     glAttachShader(program, vs);
     glAttachShader(program, fs);
     glLinkProgram(program);
@@ -140,7 +207,178 @@ auto shader::link(mno::u32 const& fs, mno::u32 const& vs) -> mno::u32 {
     glDeleteShader(fs);
     return program;
 }
-auto shader::uniform_location(std::string const& name) const -> mno::i32 {
-    return glGetUniformLocation(m_id, name.c_str());
+// Binary cache file layout: magic, binary format, binary size, binary data.
+static constexpr mno::u32 binary_magic = 0x42504E4D;  // "MNPB"
+
+static auto fnv1a(std::uint64_t hash, std::string_view const& str) -> std::uint64_t {
+    for (auto const& c : str) {
+        hash ^= std::uint64_t(static_cast<unsigned char>(c));
+        hash *= 0x100000001B3ull;
+    }
+    // Separator so "ab" + "c" and "a" + "bc" hash differently
+    return (hash ^ 0xFF) * 0x100000001B3ull;
+}
+
+static auto gl_string(GLenum const& name) -> std::string_view {
+    auto const* str = reinterpret_cast<char const*>(glGetString(name));
+    return str != nullptr ? std::string_view{str} : std::string_view{};
+}
+
+auto shader::cache_path(std::string const& vertex_source, std::string const& fragment_source) -> std::filesystem::path {
+    if (s_cache_directory.empty()) return {};
+    mno::i32 formats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+    if (formats <= 0) return {};
+
+    // A driver update changes the version string and invalidates old binaries
+    auto hash = 0xCBF29CE484222325ull;
+    hash = fnv1a(hash, gl_string(GL_VENDOR));
+    hash = fnv1a(hash, gl_string(GL_RENDERER));
+    hash = fnv1a(hash, gl_string(GL_VERSION));
+    hash = fnv1a(hash, vertex_source);
+    hash = fnv1a(hash, fragment_source);
+
+    constexpr char digits[] = "0123456789abcdef";
+    std::string name(16, '0');
+    for (auto i = name.size(); i-- > 0; hash >>= 4) name[i] = digits[hash & 0xF];
+    return s_cache_directory / (name + ".bin");
+}
+
+auto shader::load_binary(std::filesystem::path const& path) -> mno::u32 {
+    std::ifstream file{path, std::ios::binary};
+    if (!file.is_open()) return 0;
+
+    std::error_code error;
+    auto const file_size = std::filesystem::file_size(path, error);
+    mno::u32 header[3]{};
+    file.read(reinterpret_cast<char*>(header), sizeof(header));
+    // The header is checked before its size is trusted for an allocation
+    if (error || !file || header[0] != binary_magic || header[2] == 0 ||
+        header[2] > file_size - sizeof(header)) {
+        spdlog::warn("SHADER::CACHE invalid binary {}", path.string());
+        return 0;
+    }
+    std::vector<char> binary(header[2]);
+    file.read(binary.data(), std::streamsize(binary.size()));
+    if (!file) {
+        spdlog::warn("SHADER::CACHE invalid binary {}", path.string());
+        return 0;
+    }
+
+    auto program = glCreateProgram();
+    glProgramBinary(program, header[1], binary.data(), GLsizei(binary.size()));
+    mno::i32 is_success = 0;
+    glGetProgramiv(program, GL_LINK_STATUS, &is_success);
+    if (!is_success) {
+        // The driver is free to reject binaries at any time, rebuild from source
+        spdlog::warn("SHADER::CACHE binary rejected {}", path.string());
+        glDeleteProgram(program);
+        std::filesystem::remove(path, error);
+        return 0;
+    }
+    glUseProgram(program);
+    return program;
+}
+
+auto shader::save_binary(mno::u32 const& program, std::filesystem::path const& path) -> void {
+    mno::i32 length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) return;
+
+    std::vector<char> binary(std::size_t(length), 0);
+    GLenum format = 0;
+    glGetProgramBinary(program, length, &length, &format, binary.data());
+
+    std::error_code error;
+    std::filesystem::create_directories(path.parent_path(), error);
+    // Write to a temporary first so an interrupted write never leaves a truncated binary
+    auto temporary = path;
+    temporary += ".tmp";
+    {
+        std::ofstream file{temporary, std::ios::binary | std::ios::trunc};
+        mno::u32 const header[3]{binary_magic, format, mno::u32(length)};
+        file.write(reinterpret_cast<char const*>(header), sizeof(header));
+        file.write(binary.data(), length);
+        if (!file) {
+            spdlog::warn("SHADER::CACHE failed to write {}", temporary.string());
+            file.close();
+            std::filesystem::remove(temporary, error);
+            return;
+        }
+    }
+    std::filesystem::rename(temporary, path, error);
+    if (error) spdlog::warn("SHADER::CACHE failed to write {}: {}", path.string(), error.message());
+}
+
+static auto gl_to_type(GLenum const& type) -> shader::type {
+    switch (type) {
+        case GL_BOOL:              return shader::type::b8;
+        case GL_INT:               return shader::type::i32;
+        case GL_UNSIGNED_INT:      return shader::type::u32;
+        case GL_FLOAT:             return shader::type::f32;
+        case GL_DOUBLE:            return shader::type::f64;
+        case GL_FLOAT_VEC2:        return shader::type::vec2;
+        case GL_FLOAT_VEC3:        return shader::type::vec3;
+        case GL_FLOAT_VEC4:        return shader::type::vec4;
+        case GL_INT_VEC2:          return shader::type::ivec2;
+        case GL_INT_VEC3:          return shader::type::ivec3;
+        case GL_INT_VEC4:          return shader::type::ivec4;
+        case GL_DOUBLE_VEC2:       return shader::type::dvec2;
+        case GL_DOUBLE_VEC3:       return shader::type::dvec3;
+        case GL_DOUBLE_VEC4:       return shader::type::dvec4;
+        case GL_FLOAT_MAT2:        return shader::type::mat2;
+        case GL_FLOAT_MAT3:        return shader::type::mat3;
+        case GL_FLOAT_MAT4:        return shader::type::mat4;
+        // samplers are set as texture unit indices
+        case GL_SAMPLER_1D:
+        case GL_SAMPLER_2D:
+        case GL_SAMPLER_3D:
+        case GL_SAMPLER_CUBE:
+        case GL_SAMPLER_2D_ARRAY:
+        case GL_INT_SAMPLER_2D:
+        case GL_UNSIGNED_INT_SAMPLER_2D: return shader::type::i32;
+        default: return shader::type::none;
+    }
+}
+
+auto shader::reflect() -> void {
+    m_uniforms.clear();
+    mno::i32 count = 0;
+    mno::i32 max_length = 0;
+    glGetProgramiv(m_id, GL_ACTIVE_UNIFORMS, &count);
+    glGetProgramiv(m_id, GL_ACTIVE_UNIFORM_MAX_LENGTH, &max_length);
+
+    std::string name(std::size_t(std::max(max_length, 1)), '\0');
+    for (mno::i32 i = 0; i < count; i++) {
+        GLsizei length  = 0;
+        GLint   size    = 0;
+        GLenum  gl_type = 0;
+        glGetActiveUniform(m_id, GLuint(i), GLsizei(name.size()), &length, &size, &gl_type, name.data());
+        std::string uniform_name{name.data(), std::size_t(length)};
+        auto const location = glGetUniformLocation(m_id, uniform_name.c_str());
+        if (location < 0) continue;  // uniform block members
+
+        // Arrays are reported as "name[0]", make them reachable without the suffix too
+        uniform_info const info{location, gl_to_type(gl_type), size};
+        if (auto const bracket = uniform_name.find('['); bracket != std::string::npos)
+            m_uniforms.insert({uniform_name.substr(0, bracket), info});
+        m_uniforms.insert({std::move(uniform_name), info});
+    }
+}
+
+auto shader::resolve(std::string_view const& name, shader::type const& expected) const -> mno::i32 {
+    auto const it = m_uniforms.find(name);
+    if (it == std::end(m_uniforms)) return -1;
+    // A handle of the wrong type would fail every upload with GL_INVALID_OPERATION
+    if (expected != type::none && it->second.data_type != expected) {
+        spdlog::warn("SHADER::UNIFORM {} type mismatch", name);
+        return -1;
+    }
+    return it->second.location;
+}
+
+auto shader::uniform_location(std::string_view const& name) const -> mno::i32 {
+    auto const it = m_uniforms.find(name);
+    return it == std::end(m_uniforms) ? -1 : it->second.location;
 }
 }  // namespace mno
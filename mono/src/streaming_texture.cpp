@@ -0,0 +1,123 @@
+/**
+ * @file   streaming_texture.cpp
+ * @author Pratchaya Khansomboon (me@mononerv.dev)
+ * @brief  Texture fed from the CPU through a ring of pixel unpack buffers.
+ * @date   2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ */
+#include "streaming_texture.hpp"
+#include <algorithm>
+#include <cstring>
+
+#include "glad/glad.h"
+#include "spdlog/spdlog.h"
+
+namespace mno {
+streaming_texture::streaming_texture(std::int32_t const& width, std::int32_t const& height,
+                                     std::size_t const& depth, texture_format const& format)
+    : m_texture(make_ref<mno::texture>(width, height, format)),
+      m_buffers(std::max(depth, std::size_t(1)), 0),
+      m_capacity(m_buffers.size(), 0) {
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glGenBuffers(GLsizei(m_buffers.size()), m_buffers.data());
+}
+streaming_texture::~streaming_texture() noexcept {
+    glDeleteBuffers(GLsizei(m_buffers.size()), m_buffers.data());
+}
+
+auto streaming_texture::resize(std::int32_t const& width, std::int32_t const& height) -> void {
+    if (width == this->width() && height == this->height()) return;
+    m_texture->resize(width, height);
+    mark_dirty();
+}
+
+auto streaming_texture::mark_dirty(std::int32_t const& x0, std::int32_t const& y0,
+                                   std::int32_t const& x1, std::int32_t const& y1) -> void {
+    std::scoped_lock lock{m_mutex};
+    m_dirty.push_back({x0, y0, x1, y1});
+}
+auto streaming_texture::mark_dirty() -> void {
+    mark_dirty(0, 0, width(), height());
+}
+
+auto streaming_texture::flush(mno::image const& image) -> void {
+    {
+        std::scoped_lock lock{m_mutex};
+        std::swap(m_dirty, m_flushing);
+    }
+    if (m_flushing.empty()) return;
+
+    if (m_flushing.size() > max_rects) {
+        rect bounds = m_flushing.front();
+        for (auto const& r : m_flushing) {
+            bounds.x0 = std::min(bounds.x0, r.x0);
+            bounds.y0 = std::min(bounds.y0, r.y0);
+            bounds.x1 = std::max(bounds.x1, r.x1);
+            bounds.y1 = std::max(bounds.y1, r.y1);
+        }
+        m_flushing.assign(1, bounds);
+    }
+
+    m_texture->bind();
+    for (auto r : m_flushing) {
+        r.x0 = std::clamp(r.x0, 0, image.width());
+        r.x1 = std::clamp(r.x1, 0, image.width());
+        r.y0 = std::clamp(r.y0, 0, image.height());
+        r.y1 = std::clamp(r.y1, 0, image.height());
+        if (r.x0 < r.x1 && r.y0 < r.y1) upload(image, r);
+    }
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    m_flushing.clear();
+}
+
+auto streaming_texture::update(mno::image const& image) -> void {
+    mark_dirty();
+    flush(image);
+}
+
+auto streaming_texture::upload(mno::image const& image, rect const& r) -> void {
+    auto const index  = m_next;
+    m_next = (m_next + 1) % m_buffers.size();
+
+    auto const pixel    = image.pixel_size();
+    auto const row_size = std::size_t(r.x1 - r.x0) * pixel;
+    auto const size     = row_size * std::size_t(r.y1 - r.y0);
+
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_buffers[index]);
+    // Orphan the old storage, the GPU may still be reading it
+    m_capacity[index] = std::max(m_capacity[index], size);
+    glBufferData(GL_PIXEL_UNPACK_BUFFER, GLsizeiptr(m_capacity[index]), nullptr, GL_STREAM_DRAW);
+    auto* pixels = static_cast<std::uint8_t*>(glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, GLsizeiptr(size),
+        GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT | GL_MAP_UNSYNCHRONIZED_BIT));
+    if (pixels == nullptr) {
+        // Try again on the next flush, the rect is no longer in m_dirty
+        spdlog::warn("STREAMING_TEXTURE::MAP failed for [{}, {}, {}, {}]: 0x{:04X}",
+                     r.x0, r.y0, r.x1, r.y1, glGetError());
+        m_failed++;
+        mark_dirty(r.x0, r.y0, r.x1, r.y1);
+        return;
+    }
+
+    auto const stride = image.stride();
+    auto const* src = image.buffer() + std::size_t(r.y0) * stride + std::size_t(r.x0) * pixel;
+    for (auto y = r.y0; y < r.y1; y++, src += stride, pixels += row_size)
+        std::memcpy(pixels, src, row_size);
+    glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+
+    auto const transfer = pixel_transfer_of(image.format());
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, r.x0, r.y0, r.x1 - r.x0, r.y1 - r.y0,
+                    transfer.format, transfer.type, nullptr);
+}
+
+auto streaming_texture::str() const -> std::string {
+    std::string str{"mno::streaming_texture { "};
+    str += "width: "  + std::to_string(width())  + ", ";
+    str += "height: " + std::to_string(height()) + ", ";
+    str += "depth: "  + std::to_string(m_buffers.size()) + ", ";
+    str += "failed: " + std::to_string(m_failed) + " }";
+    return str;
+}
+}  // namespace mno
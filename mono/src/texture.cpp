@@ -10,37 +10,119 @@
 #include "glad/glad.h"
 
 namespace mno {
+static auto internal_format(texture_format const& format) -> GLint {
+    switch (format) {
+        case texture_format::r8:      return GL_R8;
+        case texture_format::r16:     return GL_R16;
+        case texture_format::rgba16:  return GL_RGBA16;
+        case texture_format::r32f:    return GL_R32F;
+        case texture_format::rgba16f: return GL_RGBA16F;
+        case texture_format::rgba32f: return GL_RGBA32F;
+        case texture_format::rgba8:
+        default:                      return GL_RGBA8;
+    }
+}
+
+auto texture_format_of(pixel_format const& format) -> texture_format {
+    switch (format) {
+        case pixel_format::r8:      return texture_format::r8;
+        case pixel_format::r16:     return texture_format::r16;
+        case pixel_format::rgba16:  return texture_format::rgba16;
+        case pixel_format::r32f:    return texture_format::r32f;
+        case pixel_format::rgba32f: return texture_format::rgba32f;
+        default:                    return texture_format::rgba8;
+    }
+}
+
+auto to_string(texture_format const& format) -> std::string {
+    switch (format) {
+        case texture_format::rgba8:   return "rgba8";
+        case texture_format::r8:      return "r8";
+        case texture_format::r16:     return "r16";
+        case texture_format::rgba16:  return "rgba16";
+        case texture_format::r32f:    return "r32f";
+        case texture_format::rgba16f: return "rgba16f";
+        case texture_format::rgba32f: return "rgba32f";
+        default:                      return "unknown";
+    }
+}
 
-texture::texture(std::int32_t const& width, std::int32_t const& height)
-    : m_width(width), m_height(height) {
+auto pixel_transfer_of(pixel_format const& format) -> pixel_transfer {
+    std::uint32_t const layouts[]{GL_RED, GL_RG, GL_RGB, GL_RGBA};
+    auto const type = channel_size(format) == 4 ? GL_FLOAT
+                    : channel_size(format) == 2 ? GL_UNSIGNED_SHORT
+                    : GL_UNSIGNED_BYTE;
+    return {layouts[channel_count(format) - 1], std::uint32_t(type)};
+}
+
+// Padded image rows are described to GL in pixels, call reset_unpack() after the upload.
+static auto unpack(mno::image const& image) -> pixel_transfer {
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, GLint(image.stride() / image.pixel_size()));
+    return pixel_transfer_of(image.format());
+}
+static auto reset_unpack() -> void {
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+}
+
+static auto set_swizzle(texture_format const& format) -> void {
+    auto const is_single = format == texture_format::r8 || format == texture_format::r16 ||
+                           format == texture_format::r32f;
+    if (!is_single) return;
+    GLint const swizzle[]{GL_RED, GL_RED, GL_RED, GL_ONE};
+    glTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_RGBA, swizzle);
+}
+
+texture::texture(std::int32_t const& width, std::int32_t const& height, texture_format const& format)
+    : m_width(width), m_height(height), m_format(format) {
     glGenTextures(1, &m_buffer);
     glBindTexture(GL_TEXTURE_2D, m_buffer);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, m_width, m_height, 0,
+    glTexImage2D(GL_TEXTURE_2D, 0, internal_format(m_format), m_width, m_height, 0,
                  GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    set_swizzle(m_format);
 }
-texture::texture(mno::image const& image)
-    : m_width(image.width()), m_height(image.height()) {
+texture::texture(mno::image const& image) : texture(image, texture_format_of(image.format())) {}
+texture::texture(mno::image const& image, texture_format const& format)
+    : m_width(image.width()), m_height(image.height()), m_format(format) {
     glGenTextures(1, &m_buffer);
     glBindTexture(GL_TEXTURE_2D, m_buffer);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, image.width(), image.height(), 0,
-                 GL_RGBA, GL_UNSIGNED_BYTE, image.buffer());
+    auto const transfer = unpack(image);
+    glTexImage2D(GL_TEXTURE_2D, 0, internal_format(m_format), image.width(), image.height(), 0,
+                 transfer.format, transfer.type, image.buffer());
+    reset_unpack();
+    set_swizzle(m_format);
 }
 texture::~texture() {
     glDeleteTextures(1, &m_buffer);
 }
 auto texture::set_image(mno::image const& image) -> void {
+    glBindTexture(GL_TEXTURE_2D, m_buffer);
+    auto const transfer = unpack(image);
+    // Same size keeps the storage and only copies the pixels
+    if (m_width == image.width() && m_height == image.height()) {
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, m_width, m_height,
+                        transfer.format, transfer.type, image.buffer());
+        reset_unpack();
+        return;
+    }
     m_width = image.width();
     m_height = image.height();
-    glBindTexture(GL_TEXTURE_2D, m_buffer);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, image.width(), image.height(), 0,
-                 GL_RGBA, GL_UNSIGNED_BYTE, image.buffer());
+    glTexImage2D(GL_TEXTURE_2D, 0, internal_format(m_format), image.width(), image.height(), 0,
+                 transfer.format, transfer.type, image.buffer());
+    reset_unpack();
 }
 auto texture::resize(std::int32_t const& width, std::int32_t const& height) -> void {
     m_width  = width;
     m_height = height;
     glBindTexture(GL_TEXTURE_2D, m_buffer);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, m_width, m_height, 0,
-                 GL_RGB, GL_UNSIGNED_BYTE, nullptr);
+    glTexImage2D(GL_TEXTURE_2D, 0, internal_format(m_format), m_width, m_height, 0,
+                 GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+}
+auto texture::set_filter(texture_filter const& filter) -> void {
+    auto const mode = filter == texture_filter::linear ? GL_LINEAR : GL_NEAREST;
+    glBindTexture(GL_TEXTURE_2D, m_buffer);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, mode);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, mode);
 }
 auto texture::bind(std::uint32_t const& id) const -> void {
     glActiveTexture(GL_TEXTURE0 + id);
@@ -0,0 +1,136 @@
+/**
+ * @file   tile_scheduler.cpp
+ * @author Pratchaya Khansomboon (me@mononerv.dev)
+ * @brief  Tile based work-stealing scheduler for CPU image rendering.
+ * @date   2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ */
+#include "tile_scheduler.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace mno {
+tile_scheduler::tile_scheduler(std::uint32_t const& threads, std::int32_t const& tile_size)
+    : m_tile_size(std::max(tile_size, 1)) {
+    auto const count = std::max(threads, 1u);
+    for (std::uint32_t i = 0; i < count; i++)
+        m_queues.emplace_back(make_local<queue>());
+    // The last queue belongs to the thread calling run()
+    for (std::uint32_t i = 0; i + 1 < count; i++)
+        m_workers.emplace_back([this, i] { worker(i); });
+}
+tile_scheduler::~tile_scheduler() {
+    {
+        std::scoped_lock lock{m_mutex};
+        m_stop = true;
+    }
+    m_start.notify_all();
+    for (auto& thread : m_workers) thread.join();
+}
+
+auto tile_scheduler::run(mno::image const& image, tile_fn const& fn) -> void {
+    run(image.width(), image.height(), fn);
+}
+
+auto tile_scheduler::run(std::int32_t const& width, std::int32_t const& height, tile_fn const& fn) -> void {
+    if (width <= 0 || height <= 0) return;
+    auto const size    = m_tile_size;
+    auto const columns = (width  + size - 1) / size;
+    auto const rows    = (height + size - 1) / size;
+    auto const count   = std::size_t(columns) * std::size_t(rows);
+
+    m_fn    = &fn;
+    m_error = nullptr;
+    m_pending.store(count, std::memory_order_release);
+
+    // Hand out contiguous runs of tiles so neighbours start on the same
+    // core, stealing evens out whatever the escape-time cost does.
+    auto const queues = m_queues.size();
+    std::uint32_t index = 0;
+    for (std::int32_t ty = 0; ty < rows; ty++) {
+        for (std::int32_t tx = 0; tx < columns; tx++, index++) {
+            tile const t{
+                tx * size, ty * size,
+                std::min((tx + 1) * size, width), std::min((ty + 1) * size, height),
+                index
+            };
+            auto& q = *m_queues[std::size_t(index) * queues / count];
+            std::scoped_lock lock{q.mutex};
+            q.tiles.push_back(t);
+        }
+    }
+
+    {
+        std::scoped_lock lock{m_mutex};
+        m_generation++;
+    }
+    m_start.notify_all();
+
+    work(queues - 1);
+
+    std::unique_lock lock{m_mutex};
+    m_done.wait(lock, [this] { return m_pending.load(std::memory_order_acquire) == 0; });
+    m_fn = nullptr;
+    if (m_error) std::rethrow_exception(std::exchange(m_error, nullptr));
+}
+
+auto tile_scheduler::worker(std::size_t const& index) -> void {
+    std::uint64_t seen = 0;
+    while (true) {
+        {
+            std::unique_lock lock{m_mutex};
+            m_start.wait(lock, [&] { return m_stop || m_generation != seen; });
+            if (m_stop) return;
+            seen = m_generation;
+        }
+        work(index);
+    }
+}
+
+auto tile_scheduler::work(std::size_t const& index) -> void {
+    tile t{};
+    while (pop(index, t) || steal(index, t)) {
+        try {
+            (*m_fn)(t);
+        } catch (...) {
+            std::scoped_lock lock{m_mutex};
+            if (!m_error) m_error = std::current_exception();
+        }
+        if (m_pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            std::scoped_lock lock{m_mutex};
+            m_done.notify_all();
+        }
+    }
+}
+
+auto tile_scheduler::pop(std::size_t const& index, tile& out) -> bool {
+    auto& q = *m_queues[index];
+    std::scoped_lock lock{q.mutex};
+    if (q.tiles.empty()) return false;
+    out = q.tiles.front();
+    q.tiles.pop_front();
+    return true;
+}
+
+auto tile_scheduler::steal(std::size_t const& index, tile& out) -> bool {
+    auto const count = m_queues.size();
+    for (std::size_t i = 1; i < count; i++) {
+        auto& q = *m_queues[(index + i) % count];
+        std::scoped_lock lock{q.mutex};
+        if (q.tiles.empty()) continue;
+        out = q.tiles.back();
+        q.tiles.pop_back();
+        return true;
+    }
+    return false;
+}
+
+auto tile_scheduler::str() const -> std::string {
+    std::string str{"mno::tile_scheduler { "};
+    str += "threads: "   + std::to_string(thread_count()) + ", ";
+    str += "tile_size: " + std::to_string(m_tile_size) + " }";
+    return str;
+}
+}  // namespace mno
@@ -6,13 +6,21 @@
  *
  * @copyright Copyright (c) 2022
  */
-#include <algorithm>
+#include <cstdlib>
+#include <utility>
+#include <variant>
 #include "window.hpp"
 
 #include "glad/glad.h"
 #include "spdlog/spdlog.h"
 
 namespace mno {
+template <typename Event>
+auto window::enqueue(GLFWwindow* window, Event const& event) -> void {
+    auto data = mno::window::user_ptr(window);
+    if (!data->queue.try_push(event)) data->dropped.fetch_add(1, std::memory_order_relaxed);
+}
+
 static auto setup_opengl() -> void {
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
     glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 1);
@@ -20,12 +28,29 @@ static auto setup_opengl() -> void {
     glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
 }
 
+static auto setup_headless() -> void {
+#if defined(__linux__) && defined(GLFW_PLATFORM_NULL)
+    // No display server to connect to, let GLFW create an OSMesa context instead
+    auto const has_display = std::getenv("DISPLAY") != nullptr || std::getenv("WAYLAND_DISPLAY") != nullptr;
+    if (!has_display) glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+#endif
+}
+
 window::window(const window_props &props) {
+    if (props.headless) mno::setup_headless();
     if (!glfwInit()) throw std::runtime_error("Error initializing GLFW!");
     mno::setup_opengl();
-    m_data.title  = props.title;
-    m_data.width  = props.width;
-    m_data.height = props.height;
+    if (props.headless) {
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+#ifdef GLFW_PLATFORM_NULL
+        if (glfwGetPlatform() == GLFW_PLATFORM_NULL)
+            glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_OSMESA_CONTEXT_API);
+#endif
+    }
+    m_data.title    = props.title;
+    m_data.width    = props.width;
+    m_data.height   = props.height;
+    m_data.headless = props.headless;
     m_window = glfwCreateWindow(m_data.width, m_data.height, m_data.title.c_str(), nullptr, nullptr);
     if (m_window == nullptr) {
         glfwTerminate();
@@ -42,221 +67,83 @@ window::window(const window_props &props) {
         throw std::runtime_error("Error failed to load glad!\n");
     }
 
-    // Register events
+    // Register events, the callbacks update the cached state and queue the event
     glfwSetWindowUserPointer(m_window, &m_data);
-    // TODO: Better event systems, right now this calls the event handler for each event.
+    m_dispatch_on_poll = props.dispatch_on_poll;
     glfwSetWindowSizeCallback(m_window,
     [](GLFWwindow* window, std::int32_t width, std::int32_t height) {
         auto data = mno::window::user_ptr(window);
         data->width  = width;
         data->height = height;
-
-        auto it = data->events.find(event_type::window_resize);
-        if (it == data->events.end()) return;
-        auto const& fns = it->second;
-        auto event = window_resize_event(width, height);
-        std::for_each(std::begin(fns), std::end(fns), [&](auto const& fn) {
-            fn.second(event);
-        });
+        enqueue(window, window_resize_event(width, height));
     });
     glfwSetWindowPosCallback(m_window,
     [](GLFWwindow* window, std::int32_t xpos, std::int32_t ypos) {
         auto data = mno::window::user_ptr(window);
         data->xpos = xpos;
         data->ypos = ypos;
-
-        auto it = data->events.find(event_type::window_move);
-        if (it == data->events.end()) return;
-        auto const& fns = it->second;
-        auto event = window_move_event(xpos, ypos);
-        std::for_each(std::begin(fns), std::end(fns), [&](auto const& fn) {
-            fn.second(event);
-        });
+        enqueue(window, window_move_event(xpos, ypos));
     });
     glfwSetWindowFocusCallback(m_window, [](GLFWwindow* window, std::int32_t focused){
-        auto data = mno::window::user_ptr(window);
-
-        auto it = data->events.find(event_type::window_focus);
-        if (it == data->events.end()) return;
-        auto const& fns = it->second;
-        auto event = window_focus_event(focused);
-        std::for_each(std::begin(fns), std::end(fns), [&](auto const& fn) {
-            fn.second(event);
-        });
+        enqueue(window, window_focus_event(focused));
     });
     glfwSetWindowIconifyCallback(m_window, [](GLFWwindow* window, std::int32_t iconified) {
-        auto data = mno::window::user_ptr(window);
-
-        auto it = data->events.find(event_type::window_icon);
-        if (it == data->events.end()) return;
-        auto const& fns = it->second;
-        auto event = window_icon_event(iconified);
-        std::for_each(std::begin(fns), std::end(fns), [&](auto const& fn) {
-            fn.second(event);
-        });
+        enqueue(window, window_icon_event(iconified));
     });
     glfwSetWindowMaximizeCallback(m_window, [](GLFWwindow* window, std::int32_t maximized) {
-        auto data = mno::window::user_ptr(window);
-
-        auto it = data->events.find(event_type::window_maximize);
-        if (it == data->events.end()) return;
-        auto const& fns = it->second;
-        auto event = window_maximize_event(maximized);
-        std::for_each(std::begin(fns), std::end(fns), [&](auto const& fn) {
-            fn.second(event);
-        });
+        enqueue(window, window_maximize_event(maximized));
     });
     glfwSetFramebufferSizeCallback(m_window,
     [](GLFWwindow* window, std::int32_t width, std::int32_t height) {
         auto data = mno::window::user_ptr(window);
         data->buffer_width  = width;
         data->buffer_height = height;
-
-        auto it = data->events.find(event_type::buffer_resize);
-        if (it == data->events.end()) return;
-        auto const& fns = it->second;
-        auto event = buffer_resize_event(width, height);
-        std::for_each(std::begin(fns), std::end(fns), [&](auto const& fn) {
-            fn.second(event);
-        });
+        enqueue(window, buffer_resize_event(width, height));
     });
     glfwSetWindowContentScaleCallback(m_window,
     [](GLFWwindow* window, f32 xscale, f32 yscale){
         auto data = mno::window::user_ptr(window);
         data->xscale = xscale;
         data->yscale = yscale;
-
-        auto it = data->events.find(event_type::content_scale);
-        if (it == data->events.end()) return;
-        auto const& fns = it->second;
-        auto ev = content_scale_event(xscale, yscale);
-        std::for_each(std::begin(fns), std::end(fns), [&](auto const& fn) {
-            fn.second(ev);
-        });
+        enqueue(window, content_scale_event(xscale, yscale));
     });
     glfwSetCursorPosCallback(m_window,
     [](GLFWwindow* window, mno::f64 xpos, mno::f64 ypos) {
-        auto data = mno::window::user_ptr(window);
-
-        auto it = data->events.find(event_type::mouse_move);
-        if (it == data->events.end()) return;
-        auto const& fns = it->second;
-        auto event = mouse_move_event(xpos, ypos);
-        std::for_each(std::begin(fns), std::end(fns), [&](auto const& fn) {
-            fn.second(event);
-        });
+        enqueue(window, mouse_move_event(xpos, ypos));
     });
     glfwSetCursorEnterCallback(m_window, [](GLFWwindow* window, std::int32_t entered) {
-       auto data = mno::window::user_ptr(window);
         mno::f64 pos_x, pos_y;
         glfwGetCursorPos(window, &pos_x, &pos_y);
-
-        if (entered) {
-            auto it = data->events.find(event_type::mouse_enter);
-            if (it == data->events.end()) return;
-            auto const& fns = it->second;
-
-            auto event = mouse_enter_event(pos_x, pos_y);
-            std::for_each(std::begin(fns), std::end(fns), [&](auto const& fn) {
-                fn.second(event);
-            });
-        } else {
-            auto it = data->events.find(event_type::mouse_leave);
-            if (it == data->events.end()) return;
-            auto fns = it->second;
-
-            auto event = mouse_leave_event(pos_x, pos_y);
-            std::for_each(std::begin(fns), std::end(fns), [&](auto const& fn) {
-                fn.second(event);
-            });
-        }
+        if (entered) enqueue(window, mouse_enter_event(pos_x, pos_y));
+        else         enqueue(window, mouse_leave_event(pos_x, pos_y));
     });
     glfwSetMouseButtonCallback(m_window,
     [](GLFWwindow* window, std::int32_t button, std::int32_t action, std::int32_t mods) {
-        auto data = mno::window::user_ptr(window);
         mno::f64 pos_x, pos_y;
         glfwGetCursorPos(window, &pos_x, &pos_y);
-
-        if (action == GLFW_PRESS) {
-            auto it = data->events.find(event_type::mouse_press);
-            if (it == data->events.end()) return;
-            auto const& fns = it->second;
-
-            auto event = mouse_press_event(button, mods, pos_x, pos_y);
-            std::for_each(std::begin(fns), std::end(fns), [&](auto const& fn) {
-                fn.second(event);
-            });
-        } else {
-            auto it = data->events.find(event_type::mouse_release);
-            if (it == data->events.end()) return;
-            auto const& fns = it->second;
-
-            auto event = mouse_release_event(button, mods, pos_x, pos_y);
-            std::for_each(std::begin(fns), std::end(fns), [&](auto const& fn) {
-                fn.second(event);
-            });
-        }
+        if (action == GLFW_PRESS) enqueue(window, mouse_press_event(button, mods, pos_x, pos_y));
+        else                      enqueue(window, mouse_release_event(button, mods, pos_x, pos_y));
     });
     glfwSetScrollCallback(m_window,
     [](GLFWwindow* window, f64 xoffset, f64 yoffset){
-        auto data = mno::window::user_ptr(window);
-        auto it = data->events.find(event_type::mouse_wheel);
-        if (it == data->events.end()) return;
-        auto const& fns = it->second;
         mno::f64 x, y;
         glfwGetCursorPos(window, &x, &y);
-        auto event = mouse_wheel_event(xoffset, yoffset, x, y);
-        std::for_each(std::begin(fns), std::end(fns), [&](auto const& fn) {
-            fn.second(event);
-        });
+        enqueue(window, mouse_wheel_event(xoffset, yoffset, x, y));
     });
     glfwSetKeyCallback(m_window,
     [](GLFWwindow* window, std::int32_t key, std::int32_t code, std::int32_t action, std::int32_t mods) {
-        auto data = mno::window::user_ptr(window);
-        if (action == GLFW_PRESS || action == GLFW_REPEAT) {
-            auto it = data->events.find(event_type::key_down);
-            if (it == data->events.end()) return;
-            auto const& fns = it->second;
-
-            auto event = key_down_event(key, code, mods, action == GLFW_REPEAT);
-            std::for_each(std::begin(fns), std::end(fns), [&](auto const& fn) {
-                fn.second(event);
-            });
-        } else {
-            auto it = data->events.find(event_type::key_up);
-            if (it == data->events.end()) return;
-            auto fns = it->second;
-
-            auto event = key_up_event(key, code, mods);
-            std::for_each(std::begin(fns), std::end(fns), [&](auto const& fn) {
-                fn.second(event);
-            });
-        }
+        if (action == GLFW_PRESS || action == GLFW_REPEAT)
+            enqueue(window, key_down_event(key, code, mods, action == GLFW_REPEAT));
+        else
+            enqueue(window, key_up_event(key, code, mods));
     });
     glfwSetCharCallback(m_window,
     [](GLFWwindow* window, unsigned int codepoint) {
-        auto data = mno::window::user_ptr(window);
-        auto it = data->events.find(event_type::key_typed);
-        if (it == data->events.end()) return;
-        auto const& fns = it->second;
-
-        auto event = key_typed_event(codepoint);
-        std::for_each(std::begin(fns), std::end(fns), [&](auto const& fn) {
-            fn.second(event);
-        });
+        enqueue(window, key_typed_event(codepoint));
     });
     glfwSetDropCallback(m_window,
     [](GLFWwindow* window, std::int32_t count, char const** paths){
-        auto data = mno::window::user_ptr(window);
-        auto it = data->events.find(event_type::drop);
-        if (it == data->events.end()) return;
-
-        std::vector<std::string> vec_paths{paths, paths + count};
-        auto const& fns = it->second;
-        auto event = drop_event(vec_paths);
-        std::for_each(std::begin(fns), std::end(fns), [&](auto const& fn) {
-            fn.second(event);
-        });
+        enqueue(window, drop_event(std::vector<std::string>{paths, paths + count}));
     });
     glfwGetFramebufferSize(m_window, &m_data.buffer_width, &m_data.buffer_height);
 
@@ -290,7 +177,47 @@ auto window::content_scale(mno::f32& x, mno::f32& y) const -> void {
     y = m_data.yscale;
 }
 auto window::swap() -> void { glfwSwapBuffers(m_window); }
-auto window::poll() -> void { glfwPollEvents(); }
+auto window::poll() -> void {
+    glfwPollEvents();
+    if (m_dispatch_on_poll) dispatch();
+}
+auto window::dispatch() -> void {
+    // Listeners may throw, the flag is cleared and the listener changes they
+    // made are applied however dispatch is left
+    struct dispatch_scope {
+        window& self;
+        explicit dispatch_scope(window& owner) : self(owner) { self.m_is_dispatching = true; }
+        ~dispatch_scope() {
+            self.m_is_dispatching = false;
+            auto const pending = std::move(self.m_pending);
+            self.m_pending.clear();
+            for (auto const& [type, listener] : pending) self.change_listener(type, listener.first, listener.second);
+        }
+    } const scope{*this};
+
+    event_variant record;
+    while (m_data.queue.try_pop(record)) {
+        std::visit([&](auto const& event) {
+            if constexpr (!std::is_same_v<std::decay_t<decltype(event)>, std::monostate>) {
+                for (auto const& fn : m_listeners[std::size_t(event.type())]) fn.second(event);
+            }
+        }, record);
+    }
+}
+auto window::change_listener(event_type const& type, std::size_t const& id, event_fn const& fn) -> void {
+    if (m_is_dispatching) {
+        m_pending.push_back({type, {id, fn}});
+        return;
+    }
+    auto& fns = m_listeners[std::size_t(type)];
+    if (fn == nullptr) {
+        std::erase_if(fns, [&](auto const& listener) { return listener.first == id; });
+        return;
+    }
+    for (auto const& listener : fns)
+        if (listener.first == id) return;
+    fns.emplace_back(id, fn);
+}
 auto window::time() const -> mno::f64 { return glfwGetTime(); }
 
 auto window::mouse_pos(mno::f64 &x, mno::f64 &y) const -> void {
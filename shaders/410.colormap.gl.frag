@@ -0,0 +1,21 @@
+#version 410 core
+layout(location = 0) out vec4 o_color;
+
+in vec4 io_color;
+in vec2 io_uv;
+uniform sampler2D u_texture;  // escape counts, r32f
+uniform float u_max_iterations;
+
+// Same palette as nrv::mandelbrot::color
+void main() {
+    float n = texture(u_texture, io_uv).r;
+    if (n >= u_max_iterations) {
+        o_color = vec4(0.0, 0.0, 0.0, 1.0);
+        return;
+    }
+    float t = n / u_max_iterations;
+    float s = 1.0 - t;
+    o_color = vec4(min( 9.0 * s * t * t * t, 1.0),
+                   min(15.0 * s * s * t * t, 1.0),
+                   min( 8.5 * s * s * s * t, 1.0), 1.0);
+}
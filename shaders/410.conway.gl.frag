@@ -6,13 +6,17 @@ layout(location = 0) out vec4 o_color;
 in vec4 io_color;
 in vec2 io_uv;
 
-uniform uint  u_frame;
-uniform float u_time;
-uniform vec2  u_res;
-uniform vec2  u_mouse;
+// Shared per-frame parameters, layout must match nrv::frame_params
+layout(std140) uniform frame_params {
+    vec2  u_resolution;
+    vec2  u_mouse;
+    vec2  u_location;
+    float u_time;
+    float u_zoom;
+    uint  u_frame;
+};
 uniform vec4  u_color;
-uniform sampler2D u_texture;
-uniform sampler2D u_texture1;
+uniform sampler2D u_texture1;  // previous generation, same size as the target
 
 int get_neighbors(ivec2 p) {
     int num = 0;
@@ -26,17 +30,10 @@ int get_neighbors(ivec2 p) {
 }
 
 void main() {
-    vec2 uv = (io_uv - 0.5) * u_res / u_res.y;
-    vec4 color = vec4(0.0);
-    if (u_frame < 1) {
-        color = texture(u_texture, io_uv);
-        o_color = color;
-        return;
-    }
-    bool alive = texelFetch(u_texture1, ivec2(io_uv * u_res), 0).r > 0.5;
-    int num = get_neighbors(ivec2(io_uv * u_res));
+    // The target matches the previous generation texel for texel
+    ivec2 cell = ivec2(gl_FragCoord.xy);
+    bool alive = texelFetch(u_texture1, cell, 0).r > 0.5;
+    int num = get_neighbors(cell);
     int next = (alive && num == 2 || num == 3) ? 1 : 0;
-    color = vec4(next);
-    o_color = color;
+    o_color = vec4(next);
 }
-
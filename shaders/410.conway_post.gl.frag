@@ -5,18 +5,24 @@ layout(location = 0) out vec4 color;
 in vec4 io_color;
 in vec2 io_uv;
 
-uniform float u_zoom;
-uniform vec2 u_location;
-uniform vec2 u_res;
+// Shared per-frame parameters, layout must match nrv::frame_params
+layout(std140) uniform frame_params {
+    vec2  u_resolution;
+    vec2  u_mouse;
+    vec2  u_location;
+    float u_time;
+    float u_zoom;
+    uint  u_frame;
+};
 uniform sampler2D u_texture;
 
 void main() {
     vec2 sample_location = (io_uv - 0.5) * u_zoom + u_location + 0.5;
     color = texture(u_texture, sample_location);
 
-    if (sample_location.x * u_res.x < 0.0 || sample_location.x * u_res.x > u_res.x)
+    if (sample_location.x * u_resolution.x < 0.0 || sample_location.x * u_resolution.x > u_resolution.x)
         color = vec4(0.0);
-    if (sample_location.y * u_res.y < 0.0 || sample_location.y * u_res.y > u_res.y)
+    if (sample_location.y * u_resolution.y < 0.0 || sample_location.y * u_resolution.y > u_resolution.y)
         color = vec4(0.0);
 }
 
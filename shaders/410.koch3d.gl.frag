@@ -13,10 +13,18 @@ layout(location = 0) out vec4 color;
 
 in vec4 io_color;
 in vec2 io_uv;
-uniform float     u_time;
-uniform vec2      u_resolution;
-uniform vec2      u_mouse;
+// Shared per-frame parameters, layout must match nrv::frame_params
+layout(std140) uniform frame_params {
+    vec2  u_resolution;
+    vec2  u_mouse;
+    vec2  u_location;
+    float u_time;
+    float u_zoom;
+    uint  u_frame;
+};
 uniform sampler2D u_texture;
+// Step budget of the ray march, 0 or unset means MAX_STEPS
+uniform int u_max_steps;
 
 mat2 rot(float a) {
     float s = sin(a), c = cos(a);
@@ -87,7 +95,8 @@ float get_dist(vec3 p) {
 
 float ray_march(vec3 ray_origin, vec3 ray_direction) {
     float distance = 0.0;
-    for (int i = 0; i < MAX_STEPS; i++) {
+    int steps = u_max_steps > 0 ? min(u_max_steps, MAX_STEPS) : MAX_STEPS;
+    for (int i = 0; i < steps; i++) {
         vec3 point = ray_origin + ray_direction * distance;
         float d_s = get_dist(point);
         distance  += d_s;
@@ -1,23 +1,38 @@
 #version 410 core
 layout(location = 0) out vec4 o_color;
 
-#define PI 3.14159265359
-
 in vec4 io_color;
 in vec2 io_uv;
 
-uniform float u_time;
-uniform vec2  u_res;
-uniform vec2  u_mouse;
-uniform vec4  u_color;
-uniform sampler2D u_texture;
+// Shared per-frame parameters, layout must match nrv::frame_params
+layout(std140) uniform frame_params {
+    vec2  u_resolution;
+    vec2  u_mouse;
+    vec2  u_location;
+    float u_time;
+    float u_zoom;
+    uint  u_frame;
+};
+uniform float u_max_iterations;
 
+// Escape-time Mandelbrot in f32, u_location is the view centre and u_zoom
+// its width in the complex plane like nrv::mandelbrot_view. Same palette
+// as nrv::mandelbrot::color.
 void main() {
-    vec2 uv = (io_uv - 0.5) * u_res / u_res.y;
-    vec3 color = vec3(1.0);
-
-    float x = 2.0 * PI * 0.5 * u_time;
-    color = vec3(length(uv + 0.5 * vec2(cos(x), sin(x))));
-
-    o_color = vec4(color, 1.0);
+    vec2 c = u_location + (io_uv - 0.5) * u_resolution * (u_zoom / u_resolution.x);
+    vec2 z = vec2(0.0);
+    float n = 0.0;
+    for (; n < u_max_iterations; n += 1.0) {
+        if (dot(z, z) > 4.0) break;
+        z = vec2(z.x * z.x - z.y * z.y, 2.0 * z.x * z.y) + c;
+    }
+    if (n >= u_max_iterations) {
+        o_color = vec4(0.0, 0.0, 0.0, 1.0);
+        return;
+    }
+    float t = n / u_max_iterations;
+    float s = 1.0 - t;
+    o_color = vec4(min( 9.0 * s * t * t * t, 1.0),
+                   min(15.0 * s * s * t * t, 1.0),
+                   min( 8.5 * s * s * s * t, 1.0), 1.0);
 }
@@ -0,0 +1,33 @@
+#version 410 core
+layout(location = 0) out vec4 o_color;
+
+in vec4 io_color;
+in vec2 io_uv;
+
+// Philox4x32-10, bit for bit the stream of mno::philox so a target filled
+// here matches mno::random_fill on an image of the same size.
+uniform uint u_seed_lo;
+uniform uint u_seed_hi;
+uniform uint u_threshold;  // mno::random_threshold(density)
+uniform int  u_width;      // row length of the target in pixels
+
+uvec4 philox(uint counter) {
+    uvec4 c = uvec4(counter, 0u, 0u, 0u);
+    uvec2 k = uvec2(u_seed_lo, u_seed_hi);
+    for (int r = 0; r < 10; r++) {
+        uint hi0, lo0, hi1, lo1;
+        umulExtended(0xD2511F53u, c.x, hi0, lo0);
+        umulExtended(0xCD9E8D57u, c.z, hi1, lo1);
+        c = uvec4(hi1 ^ c.y ^ k.x, lo1, hi0 ^ c.w ^ k.y, lo0);
+        k += uvec2(0x9E3779B9u, 0xBB67AE85u);
+    }
+    return c;
+}
+
+void main() {
+    ivec2 p = ivec2(gl_FragCoord.xy);
+    uint index = uint(p.y * u_width + p.x);
+    uint value = philox(index / 4u)[index % 4u];
+    float alive = (value >> 8) < u_threshold ? 1.0 : 0.0;
+    o_color = vec4(vec3(alive), 1.0);
+}
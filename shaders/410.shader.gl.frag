@@ -6,8 +6,15 @@ in vec4 io_color;
 in vec2 io_uv;
 
 uniform vec4 u_color;
-uniform float u_time;
-uniform vec2 u_resolution;
+// Shared per-frame parameters, layout must match nrv::frame_params
+layout(std140) uniform frame_params {
+    vec2  u_resolution;
+    vec2  u_mouse;
+    vec2  u_location;
+    float u_time;
+    float u_zoom;
+    uint  u_frame;
+};
 uniform sampler2D u_texture;
 
 void main() {